@@ -62,7 +62,17 @@ int main(int argc, char *argv[])
             offset += send_size;
         }
 
-        // Collect results from workers
+        // Collect results from workers in whatever order they arrive
+        MPI_Request requests[MAX_ARRAY_SIZE];  // One receive per worker
+        int seg_offset[MAX_ARRAY_SIZE];        // Where each worker's result starts
+        int seg_size[MAX_ARRAY_SIZE];          // Length of each worker's result
+        int completed[MAX_ARRAY_SIZE];         // Indices finished by MPI_Waitsome
+        int arrival_order[MAX_ARRAY_SIZE];     // Worker ranks in order of arrival
+        int arrived = 0;
+        long long sum = 0;                     // Consumed as each result lands
+        double collect_start = MPI_Wtime();
+        double first_result = 0, last_result = 0;
+
         offset = 0;
         for (int i = 1; i < size; i++)
         {
@@ -72,12 +82,47 @@ int main(int argc, char *argv[])
                 recv_size += 1;
             }
 
-            // Receive the squared segment from each worker
-            MPI_Recv(&result[offset], recv_size, MPI_INT, i, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            // Post the receive for worker i's squared segment straight into place
+            MPI_Irecv(&result[offset], recv_size, MPI_INT, i, 0, MPI_COMM_WORLD, &requests[i - 1]);
+            seg_offset[i - 1] = offset;
+            seg_size[i - 1] = recv_size;
 
             offset += recv_size;
         }
 
+        // Consume each segment as soon as it is complete, instead of waiting
+        // on rank 1 first
+        while (arrived < size - 1)
+        {
+            int outcount;
+            MPI_Waitsome(size - 1, requests, &outcount, completed, MPI_STATUSES_IGNORE);
+            double now = MPI_Wtime() - collect_start;
+
+            for (int k = 0; k < outcount; k++)
+            {
+                int w = completed[k];
+                for (int j = 0; j < seg_size[w]; j++)
+                {
+                    sum += result[seg_offset[w] + j];
+                }
+                if (arrived == 0)
+                {
+                    first_result = now;
+                }
+                arrival_order[arrived++] = w + 1;
+            }
+            last_result = now;
+        }
+
+        printf("Results arrived from workers: ");
+        for (int i = 0; i < arrived; i++)
+        {
+            printf("%d ", arrival_order[i]);
+        }
+        printf("\n");
+        printf("Time to first result: %f seconds, to last result: %f seconds\n", first_result, last_result);
+        printf("Sum of squares (reduced on arrival): %lld\n", sum);
+
         // Print the final squared array
         printf("Final squared array: ");
         for (int i = 0; i < array_size; i++)
@@ -0,0 +1,331 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atol
+#include <stdint.h> // For fixed-width integer types
+#include <string.h> // For memset
+#include <mpi.h>    // For MPI functions
+
+#define DEFAULT_ARRAY_SIZE (1 << 22) // Total number of elements in the array
+#define BLOCK_VALUES 128             // Values per bit-packed block (4 lanes x 32)
+#define MIN_COMPRESS_BYTES 16384     // Below this, latency dominates and raw is always used
+#define TAG_RAW 0                    // Result sent as plain ints
+#define TAG_PACKED 1                 // Result sent as delta + bit-packed words
+
+enum
+{
+    MODE_RAW,      // Always send raw ints (task1.c behaviour)
+    MODE_PACKED,   // Always compress
+    MODE_ADAPTIVE, // Compress only when the cost model says it is faster
+};
+
+static const char *mode_names[] = {"raw", "packed", "adaptive"};
+
+// ---------- Codec: delta + zigzag + 128-value bit-packing ----------
+//
+// Stream layout (uint32 words): [count] then for each block [width][4 * width words].
+// Values are packed "vertically": value i of a block goes to lane i % 4, so the
+// pack/unpack loops work on 4 independent 32-bit lanes and vectorize.
+
+static uint32_t zigzag(int32_t d)
+{
+    return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+}
+
+static int32_t unzigzag(uint32_t z)
+{
+    return (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+}
+
+static void pack_block(const uint32_t *in, uint32_t *out, int width)
+{
+    memset(out, 0, 4 * width * sizeof(uint32_t));
+    int bit = 0, word = 0;
+    for (int k = 0; k < 32; k++)
+    {
+        for (int lane = 0; lane < 4; lane++)
+        {
+            uint32_t v = in[4 * k + lane];
+            out[word * 4 + lane] |= v << bit;
+            if (bit + width > 32)
+                out[(word + 1) * 4 + lane] |= v >> (32 - bit);
+        }
+        bit += width;
+        if (bit >= 32)
+        {
+            bit -= 32;
+            word++;
+        }
+    }
+}
+
+static void unpack_block(const uint32_t *in, uint32_t *out, int width)
+{
+    uint32_t mask = (width == 32) ? 0xFFFFFFFFu : ((1u << width) - 1);
+    int bit = 0, word = 0;
+    for (int k = 0; k < 32; k++)
+    {
+        for (int lane = 0; lane < 4; lane++)
+        {
+            uint32_t v = in[word * 4 + lane] >> bit;
+            if (bit + width > 32)
+                v |= in[(word + 1) * 4 + lane] << (32 - bit);
+            out[4 * k + lane] = v & mask;
+        }
+        bit += width;
+        if (bit >= 32)
+        {
+            bit -= 32;
+            word++;
+        }
+    }
+}
+
+// Worst-case encoded size in words for n values
+static long max_encoded_words(long n)
+{
+    long blocks = (n + BLOCK_VALUES - 1) / BLOCK_VALUES;
+    return 1 + blocks * (1 + 4 * 32);
+}
+
+// Encode n ints, returns the number of words written
+static long encode(const int *values, long n, uint32_t *out)
+{
+    uint32_t zz[BLOCK_VALUES];
+    long pos = 0;
+    int32_t previous = 0;
+
+    out[pos++] = (uint32_t)n;
+    for (long start = 0; start < n; start += BLOCK_VALUES)
+    {
+        long count = (n - start < BLOCK_VALUES) ? n - start : BLOCK_VALUES;
+        uint32_t bits = 0;
+
+        // Deltas against the previous value, zigzagged so small negatives stay small
+        for (long i = 0; i < count; i++)
+        {
+            int32_t v = values[start + i];
+            zz[i] = zigzag((int32_t)((uint32_t)v - (uint32_t)previous));
+            previous = v;
+            bits |= zz[i];
+        }
+        for (long i = count; i < BLOCK_VALUES; i++)
+            zz[i] = 0;
+
+        int width = 0;
+        while (width < 32 && (bits >> width) != 0)
+            width++;
+
+        out[pos++] = (uint32_t)width;
+        pack_block(zz, &out[pos], width);
+        pos += 4 * width;
+    }
+    return pos;
+}
+
+// Decode a stream produced by encode(), returns the number of values
+static long decode(const uint32_t *in, int *values)
+{
+    uint32_t zz[BLOCK_VALUES];
+    long n = in[0], pos = 1;
+    int32_t previous = 0;
+
+    for (long start = 0; start < n; start += BLOCK_VALUES)
+    {
+        long count = (n - start < BLOCK_VALUES) ? n - start : BLOCK_VALUES;
+        int width = (int)in[pos++];
+        unpack_block(&in[pos], zz, width);
+        pos += 4 * width;
+
+        // Prefix sum of the deltas restores the values
+        for (long i = 0; i < count; i++)
+        {
+            previous = (int32_t)((uint32_t)previous + (uint32_t)unzigzag(zz[i]));
+            values[start + i] = previous;
+        }
+    }
+    return n;
+}
+
+// Codec throughput in raw bytes per second (encode + decode), measured on sample data
+static double measure_codec_rate(const int *sample, long n, uint32_t *scratch, int *check)
+{
+    double start_time = MPI_Wtime();
+    int reps = 0;
+    do
+    {
+        encode(sample, n, scratch);
+        decode(scratch, check);
+        reps++;
+    } while (MPI_Wtime() - start_time < 0.02);
+    return (double)reps * n * sizeof(int) / (MPI_Wtime() - start_time);
+}
+
+// Raw bandwidth from rank 1 to rank 0 in bytes per second (one large message)
+static double measure_bandwidth(int rank, int *buffer, long n)
+{
+    double start_time, elapsed = 0;
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    if (rank == 1)
+        MPI_Send(buffer, (int)n, MPI_INT, 0, TAG_RAW, MPI_COMM_WORLD);
+    else if (rank == 0)
+    {
+        MPI_Recv(buffer, (int)n, MPI_INT, 1, TAG_RAW, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        elapsed = MPI_Wtime() - start_time;
+    }
+    double bandwidth = n * sizeof(int) / (elapsed > 0 ? elapsed : 1e-9);
+    MPI_Bcast(&bandwidth, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    return bandwidth;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size;
+    long array_size = DEFAULT_ARRAY_SIZE; // Total elements in the main array
+
+    // Initialize the MPI environment
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task1_compress [array_size]
+    if (argc > 1)
+        array_size = atol(argv[1]);
+
+    if (size < 2 || array_size < size - 1)
+    {
+        if (rank == 0)
+            printf("Error: need at least 2 processes and one element per worker.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    long segment_size = array_size / (size - 1); // Base segment size for each worker
+    long remainder = array_size % (size - 1);    // Extra elements to distribute evenly
+    long max_segment = segment_size + (remainder > 0 ? 1 : 0);
+
+    int *array = NULL, *result = NULL;
+    int *segment = (int *)malloc(max_segment * sizeof(int));
+    uint32_t *packed = (uint32_t *)malloc(max_encoded_words(array_size) * sizeof(uint32_t));
+    if (rank == 0)
+    {
+        array = (int *)malloc(array_size * sizeof(int));
+        result = (int *)malloc(array_size * sizeof(int));
+
+        // Values 1 .. 30000 repeating, so the squares still fit in an int
+        for (long i = 0; i < array_size; i++)
+            array[i] = (int)(i % 30000) + 1;
+    }
+
+    // Calibration for the adaptive mode: link bandwidth and codec throughput
+    for (long i = 0; i < max_segment; i++)
+        segment[i] = (int)((i % 30000) + 1) * (int)((i % 30000) + 1);
+    double bandwidth = measure_bandwidth(rank, segment, max_segment);
+    int *check = (int *)malloc(max_segment * sizeof(int));
+    long sample = max_segment < 65536 ? max_segment : 65536;
+    double codec_rate = measure_codec_rate(segment, sample, packed, check);
+    free(check);
+
+    if (rank == 0)
+        printf("Calibration: bandwidth = %.2f GB/s, codec = %.2f GB/s\n", bandwidth / 1e9, codec_rate / 1e9);
+
+    for (int mode = MODE_RAW; mode <= MODE_ADAPTIVE; mode++)
+    {
+        double start_time, distribute_time, end_time;
+        long long raw_bytes = 0, sent_bytes = 0;
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        start_time = MPI_Wtime();
+
+        if (rank == 0)
+        { // Master process
+            // Distribute segments exactly as task1.c does (size, then data)
+            long offset = 0;
+            for (int i = 1; i < size; i++)
+            {
+                int send_size = (int)(segment_size + (i <= remainder ? 1 : 0));
+                MPI_Send(&send_size, 1, MPI_INT, i, 0, MPI_COMM_WORLD);
+                MPI_Send(&array[offset], send_size, MPI_INT, i, 0, MPI_COMM_WORLD);
+                offset += send_size;
+            }
+            distribute_time = MPI_Wtime();
+
+            // Collect results; the tag says whether the payload is packed
+            offset = 0;
+            for (int i = 1; i < size; i++)
+            {
+                MPI_Status status;
+                int count;
+                long recv_size = segment_size + (i <= remainder ? 1 : 0);
+
+                MPI_Probe(i, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+                if (status.MPI_TAG == TAG_PACKED)
+                {
+                    MPI_Get_count(&status, MPI_UINT32_T, &count);
+                    MPI_Recv(packed, count, MPI_UINT32_T, i, TAG_PACKED, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                    decode(packed, &result[offset]);
+                    sent_bytes += (long long)count * sizeof(uint32_t);
+                }
+                else
+                {
+                    MPI_Recv(&result[offset], (int)recv_size, MPI_INT, i, TAG_RAW, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                    sent_bytes += recv_size * sizeof(int);
+                }
+                raw_bytes += recv_size * sizeof(int);
+                offset += recv_size;
+            }
+            end_time = MPI_Wtime();
+
+            // Verify against the squares computed locally
+            long errors = 0;
+            for (long i = 0; i < array_size; i++)
+                if (result[i] != array[i] * array[i])
+                    errors++;
+
+            printf("Mode %-8s: distribute = %f s, collect = %f s, total = %f s\n",
+                   mode_names[mode], distribute_time - start_time, end_time - distribute_time, end_time - start_time);
+            printf("               result bytes = %lld raw, %lld sent, ratio = %.3f, saved = %.1f MB, errors = %ld\n",
+                   raw_bytes, sent_bytes, (double)sent_bytes / raw_bytes, (raw_bytes - sent_bytes) / 1e6, errors);
+        }
+        else
+        { // Worker processes
+            int recv_size;
+            MPI_Recv(&recv_size, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            MPI_Recv(segment, recv_size, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+            // Compute the square of each element in the segment
+            for (int i = 0; i < recv_size; i++)
+                segment[i] = segment[i] * segment[i];
+
+            long raw = (long)recv_size * sizeof(int);
+            int use_codec = (mode == MODE_PACKED);
+            if (mode == MODE_ADAPTIVE && raw >= MIN_COMPRESS_BYTES)
+            {
+                // Estimate the ratio from the first blocks, then compare the costs
+                // raw / bandwidth  vs  raw / codec_rate + raw * ratio / bandwidth
+                long probe = recv_size < 4096 ? recv_size : 4096;
+                double ratio = (double)encode(segment, probe, packed) * sizeof(uint32_t) / (probe * sizeof(int));
+                use_codec = 1.0 / codec_rate + ratio / bandwidth < 1.0 / bandwidth;
+            }
+
+            if (use_codec)
+            {
+                long words = encode(segment, recv_size, packed);
+                MPI_Send(packed, (int)words, MPI_UINT32_T, 0, TAG_PACKED, MPI_COMM_WORLD);
+            }
+            else
+            {
+                MPI_Send(segment, recv_size, MPI_INT, 0, TAG_RAW, MPI_COMM_WORLD);
+            }
+        }
+    }
+
+    // Clean up
+    free(array);
+    free(result);
+    free(segment);
+    free(packed);
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+    return 0;
+}
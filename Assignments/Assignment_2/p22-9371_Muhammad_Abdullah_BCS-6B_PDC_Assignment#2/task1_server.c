@@ -0,0 +1,255 @@
+#define _POSIX_C_SOURCE 199309L // For clock_gettime
+#include <stdio.h>    // For input/output functions
+#include <stdlib.h>   // For realloc and atol
+#include <string.h>   // For strcmp and strlen
+#include <time.h>     // For timing MPI_Init, before MPI_Wtime is available
+#include <sys/stat.h> // For telling a FIFO from a regular file
+#include <mpi.h>      // For MPI functions
+
+#define TAG_JOB 1    // Master -> worker: job header
+#define TAG_DATA 2   // Master -> worker: segment of the job's input
+#define TAG_RESULT 3 // Worker -> master: processed segment
+#define TAG_STOP 4   // Master -> worker: server is shutting down
+#define MAX_LINE 1024
+
+// Element-wise kernels a job can ask for; task1.c only squares
+static const char *kernel_names[] = {"square", "double", "negate", "increment"};
+#define NUM_KERNELS 4
+
+static void run_kernel(int kernel, int *values, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        switch (kernel)
+        {
+        case 0:
+            values[i] = values[i] * values[i];
+            break;
+        case 1:
+            values[i] = 2 * values[i];
+            break;
+        case 2:
+            values[i] = -values[i];
+            break;
+        default:
+            values[i] = values[i] + 1;
+            break;
+        }
+    }
+}
+
+static int kernel_id(const char *name)
+{
+    for (int k = 0; k < NUM_KERNELS; k++)
+        if (strcmp(name, kernel_names[k]) == 0)
+            return k;
+    return -1;
+}
+
+// Grow a buffer that is kept between jobs; it never shrinks, so repeated
+// jobs of similar size reuse warm memory
+static int *reserve(int *buffer, long *capacity, long n)
+{
+    if (n > *capacity)
+    {
+        *capacity = n;
+        buffer = (int *)realloc(buffer, n * sizeof(int));
+    }
+    return buffer;
+}
+
+// Input of a job: `n` binary ints from a file (as written by task1_stream gen),
+// or 1 .. n when the file is "-". Returns 0 if the file is missing or short.
+static int load_input(const char *path, int *values, long n)
+{
+    if (strcmp(path, "-") == 0)
+    {
+        for (long i = 0; i < n; i++)
+            values[i] = (int)(i % 30000) + 1;
+        return 1;
+    }
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return 0;
+    long got = (long)fread(values, sizeof(int), n, file);
+    fclose(file);
+    return got == n;
+}
+
+// Master: read job descriptors "<input|-> <kernel> <size>" one per line and
+// farm each job out exactly as task1.c does, keeping every worker alive
+// between jobs. A regular file ends the server at EOF; a FIFO is reopened so
+// new writers can keep submitting jobs until one of them writes "quit".
+static void master(int size, const char *jobs_path)
+{
+    struct stat info;
+    int is_fifo = stat(jobs_path, &info) == 0 && S_ISFIFO(info.st_mode);
+    int workers = size - 1;
+    int *array = NULL, *result = NULL;
+    long array_capacity = 0, result_capacity = 0;
+    MPI_Request requests[workers];
+
+    long jobs = 0, failed = 0;
+    long long elements = 0;
+    double busy = 0, min_latency = 1e30, max_latency = 0;
+    double server_start = MPI_Wtime();
+    char line[MAX_LINE];
+    int quit = 0;
+
+    printf("%6s %-24s %-10s %10s %14s %18s\n", "job", "input", "kernel", "size", "latency (ms)", "checksum");
+    while (!quit)
+    {
+        FILE *file = fopen(jobs_path, "r"); // Blocks on a FIFO until a writer opens it
+        if (file == NULL)
+        {
+            printf("Error: cannot open job list %s\n", jobs_path);
+            break;
+        }
+
+        while (!quit && fgets(line, sizeof(line), file) != NULL)
+        {
+            char input[MAX_LINE], kernel_name[64];
+            long n;
+
+            // Drop the newline (absent on a last line without one) and trailing blanks
+            size_t length = strlen(line);
+            while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r' ||
+                                  line[length - 1] == ' ' || line[length - 1] == '\t'))
+                line[--length] = '\0';
+            if (line[0] == '#' || line[0] == '\0')
+                continue;
+            if (strcmp(line, "quit") == 0)
+            {
+                quit = 1;
+                break;
+            }
+            int kernel = -1;
+            if (sscanf(line, "%1023s %63s %ld", input, kernel_name, &n) == 3 && n >= workers)
+                kernel = kernel_id(kernel_name);
+
+            double start_time = MPI_Wtime();
+            if (kernel >= 0)
+            {
+                array = reserve(array, &array_capacity, n);
+                result = reserve(result, &result_capacity, n);
+            }
+            if (kernel < 0 || !load_input(input, array, n))
+            {
+                printf("%6ld skipped: bad job or unreadable input: %s\n", jobs + failed + 1, line);
+                failed++;
+                continue;
+            }
+
+            // Header and segment to every worker; results land straight in place
+            int segment_size = (int)(n / workers), remainder = (int)(n % workers);
+            long offset = 0;
+            for (int i = 1; i < size; i++)
+            {
+                int header[2] = {kernel, segment_size + (i <= remainder ? 1 : 0)};
+                MPI_Send(header, 2, MPI_INT, i, TAG_JOB, MPI_COMM_WORLD);
+                MPI_Send(&array[offset], header[1], MPI_INT, i, TAG_DATA, MPI_COMM_WORLD);
+                MPI_Irecv(&result[offset], header[1], MPI_INT, i, TAG_RESULT, MPI_COMM_WORLD, &requests[i - 1]);
+                offset += header[1];
+            }
+            MPI_Waitall(workers, requests, MPI_STATUSES_IGNORE);
+            double latency = MPI_Wtime() - start_time;
+
+            long long checksum = 0;
+            for (long i = 0; i < n; i++)
+                checksum += result[i];
+
+            jobs++;
+            elements += n;
+            busy += latency;
+            min_latency = latency < min_latency ? latency : min_latency;
+            max_latency = latency > max_latency ? latency : max_latency;
+            printf("%6ld %-24s %-10s %10ld %14.3f %18lld\n", jobs + failed, input, kernel_name, n,
+                   latency * 1e3, checksum);
+            fflush(stdout);
+        }
+        fclose(file);
+        if (!is_fifo)
+            break;
+    }
+
+    for (int i = 1; i < size; i++)
+        MPI_Send(NULL, 0, MPI_INT, i, TAG_STOP, MPI_COMM_WORLD);
+
+    double uptime = MPI_Wtime() - server_start;
+    printf("Served %ld jobs (%ld skipped), %lld elements in %f seconds\n", jobs, failed, elements, uptime);
+    if (jobs > 0)
+        printf("Latency per job: mean %.3f ms, min %.3f ms, max %.3f ms; throughput %.1f jobs/s, %.2f M elements/s\n",
+               busy / jobs * 1e3, min_latency * 1e3, max_latency * 1e3, jobs / busy, elements / busy / 1e6);
+
+    free(array);
+    free(result);
+}
+
+// Worker: run jobs until the master stops the server, reusing one segment buffer
+static void worker(void)
+{
+    int *segment = NULL;
+    long capacity = 0;
+    for (;;)
+    {
+        int header[2];
+        MPI_Status status;
+        MPI_Recv(header, 2, MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        if (status.MPI_TAG == TAG_STOP)
+            break;
+
+        segment = reserve(segment, &capacity, header[1]);
+        MPI_Recv(segment, header[1], MPI_INT, 0, TAG_DATA, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        run_kernel(header[0], segment, header[1]);
+        MPI_Send(segment, header[1], MPI_INT, 0, TAG_RESULT, MPI_COMM_WORLD);
+    }
+    free(segment);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size;
+    struct timespec init_start, init_end;
+
+    // Initialize the MPI environment, timing what every one-shot run pays
+    clock_gettime(CLOCK_MONOTONIC, &init_start);
+    MPI_Init(&argc, &argv);
+    clock_gettime(CLOCK_MONOTONIC, &init_end);
+    double init_time = (init_end.tv_sec - init_start.tv_sec) + (init_end.tv_nsec - init_start.tv_nsec) * 1e-9;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task1_server job_list   (regular file, or a FIFO made with mkfifo)
+    if (size < 2 || argc < 2)
+    {
+        if (rank == 0)
+            printf("Error: need 2+ processes and a job list (file or FIFO).\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Open every master-worker connection once, before the first job arrives
+    int ping = 0;
+    MPI_Barrier(MPI_COMM_WORLD);
+    double warm_start = MPI_Wtime();
+    if (rank == 0)
+    {
+        for (int i = 1; i < size; i++)
+            MPI_Send(&ping, 1, MPI_INT, i, TAG_JOB, MPI_COMM_WORLD);
+        for (int i = 1; i < size; i++)
+            MPI_Recv(&ping, 1, MPI_INT, i, TAG_RESULT, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        printf("Server up: MPI_Init took %.3f s, connections warmed in %.3f ms\n",
+               init_time, (MPI_Wtime() - warm_start) * 1e3);
+        master(size, argv[1]);
+    }
+    else
+    {
+        MPI_Recv(&ping, 1, MPI_INT, 0, TAG_JOB, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        MPI_Send(&ping, 1, MPI_INT, 0, TAG_RESULT, MPI_COMM_WORLD);
+        worker();
+    }
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,266 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atol
+#include <string.h> // For strcmp
+#include <mpi.h>    // For MPI functions and MPI-IO
+
+#define DEFAULT_BUDGET_MB 64     // Memory budget per rank for stream buffers
+#define DEFAULT_CHUNK (1 << 16)  // Elements handed to a worker at a time
+#define TAG_WORK 1               // Master -> worker: chunk to square
+#define TAG_RESULT 2             // Worker -> master: squared chunk
+#define TAG_STOP 3               // Master -> worker: no more work
+#define VERIFY_UNREADABLE -1     // verify_output: a file could not be opened
+#define VERIFY_SHORT -2          // verify_output: output is shorter than the input
+
+// Write a test input of n ints (values 1 .. 30000 repeating) in windows
+static void generate_input(const char *path, long n)
+{
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        printf("Error: cannot create %s\n", path);
+        return;
+    }
+    int buffer[4096];
+    for (long i = 0; i < n; i += 4096)
+    {
+        long count = (n - i < 4096) ? n - i : 4096;
+        for (long j = 0; j < count; j++)
+            buffer[j] = (int)((i + j) % 30000) + 1;
+        fwrite(buffer, sizeof(int), count, file);
+    }
+    fclose(file);
+    printf("Wrote %ld ints to %s\n", n, path);
+}
+
+// Check the output file window by window against the input file, reusing two
+// of the (now idle) stream buffers so the budget still holds.
+// Returns the number of mismatches, or one of the VERIFY_ codes above.
+static long verify_output(const char *input, const char *output, long window, int *a, int *b)
+{
+    FILE *in = fopen(input, "rb"), *out = fopen(output, "rb");
+    long errors = 0, count;
+    if (in == NULL || out == NULL)
+        errors = VERIFY_UNREADABLE;
+    while (errors >= 0 && (count = (long)fread(a, sizeof(int), window, in)) > 0)
+    {
+        if ((long)fread(b, sizeof(int), count, out) != count)
+        {
+            errors = VERIFY_SHORT;
+            break;
+        }
+        for (long i = 0; i < count; i++)
+            if (b[i] != a[i] * a[i])
+                errors++;
+    }
+    if (in)
+        fclose(in);
+    if (out)
+        fclose(out);
+    return errors;
+}
+
+// Master: read windows with MPI-IO, farm chunks out to whichever worker is
+// free, and write each finished window back while the next one is processed.
+// Two input and two output buffers of `window` elements stay within the budget.
+static void master(int size, const char *input, const char *output, long window, long chunk)
+{
+    MPI_File in_file, out_file;
+    MPI_Offset file_bytes;
+
+    if (MPI_File_open(MPI_COMM_SELF, input, MPI_MODE_RDONLY, MPI_INFO_NULL, &in_file) != MPI_SUCCESS)
+    {
+        printf("Error: cannot open %s\n", input);
+        for (int w = 1; w < size; w++)
+            MPI_Send(NULL, 0, MPI_INT, w, TAG_STOP, MPI_COMM_WORLD);
+        return;
+    }
+    if (MPI_File_open(MPI_COMM_SELF, output, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &out_file) !=
+        MPI_SUCCESS)
+    {
+        printf("Error: cannot create %s\n", output);
+        MPI_File_close(&in_file);
+        for (int w = 1; w < size; w++)
+            MPI_Send(NULL, 0, MPI_INT, w, TAG_STOP, MPI_COMM_WORLD);
+        return;
+    }
+    MPI_File_get_size(in_file, &file_bytes);
+    MPI_File_set_size(out_file, file_bytes);
+    long total = (long)(file_bytes / sizeof(int));
+
+    int *in_buf[2], *out_buf[2];
+    MPI_Request read_req[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+    MPI_Request write_req[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+    for (int b = 0; b < 2; b++)
+    {
+        in_buf[b] = (int *)malloc(window * sizeof(int));
+        out_buf[b] = (int *)malloc(window * sizeof(int));
+    }
+
+    long num_windows = (total + window - 1) / window;
+    long assigned[size]; // Offset (within the window) of each worker's chunk
+    double wait_io = 0, start_time = MPI_Wtime();
+
+    // Prefetch the first window
+    if (num_windows > 0)
+        MPI_File_iread_at(in_file, 0, in_buf[0], (int)(total < window ? total : window), MPI_INT, &read_req[0]);
+
+    for (long w = 0; w < num_windows; w++)
+    {
+        int cur = (int)(w % 2);
+        long length = (total - w * window < window) ? total - w * window : window;
+        double t = MPI_Wtime();
+
+        // Wait for this window's read and for the previous write from this output buffer
+        MPI_Wait(&read_req[cur], MPI_STATUS_IGNORE);
+        MPI_Wait(&write_req[cur], MPI_STATUS_IGNORE);
+        wait_io += MPI_Wtime() - t;
+
+        // Start reading the next window while this one is being computed
+        if (w + 1 < num_windows)
+        {
+            long next_length = (total - (w + 1) * window < window) ? total - (w + 1) * window : window;
+            MPI_File_iread_at(in_file, (MPI_Offset)(w + 1) * window * sizeof(int), in_buf[1 - cur],
+                              (int)next_length, MPI_INT, &read_req[1 - cur]);
+        }
+
+        // Dispatch chunks: one outstanding chunk per worker, refilled as results arrive
+        long next = 0;
+        int busy = 0;
+        for (int worker = 1; worker < size && next < length; worker++)
+        {
+            long count = (length - next < chunk) ? length - next : chunk;
+            MPI_Send(&in_buf[cur][next], (int)count, MPI_INT, worker, TAG_WORK, MPI_COMM_WORLD);
+            assigned[worker] = next;
+            next += count;
+            busy++;
+        }
+        while (busy > 0)
+        {
+            MPI_Status status;
+            int count;
+            MPI_Probe(MPI_ANY_SOURCE, TAG_RESULT, MPI_COMM_WORLD, &status);
+            MPI_Get_count(&status, MPI_INT, &count);
+            int worker = status.MPI_SOURCE;
+            MPI_Recv(&out_buf[cur][assigned[worker]], count, MPI_INT, worker, TAG_RESULT,
+                     MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            busy--;
+
+            if (next < length)
+            {
+                long send = (length - next < chunk) ? length - next : chunk;
+                MPI_Send(&in_buf[cur][next], (int)send, MPI_INT, worker, TAG_WORK, MPI_COMM_WORLD);
+                assigned[worker] = next;
+                next += send;
+                busy++;
+            }
+        }
+
+        // Write the finished window back without waiting for it
+        MPI_File_iwrite_at(out_file, (MPI_Offset)w * window * sizeof(int), out_buf[cur],
+                           (int)length, MPI_INT, &write_req[cur]);
+    }
+
+    double t = MPI_Wtime();
+    MPI_Waitall(2, write_req, MPI_STATUSES_IGNORE);
+    double end_time = MPI_Wtime();
+    wait_io += end_time - t;
+
+    for (int w = 1; w < size; w++)
+        MPI_Send(NULL, 0, MPI_INT, w, TAG_STOP, MPI_COMM_WORLD);
+
+    MPI_File_close(&in_file);
+    MPI_File_close(&out_file);
+
+    double elapsed = end_time - start_time;
+    double bytes = (double)total * sizeof(int);
+    printf("Streamed %ld ints (%.1f MB) in %ld windows of %ld ints, chunk %ld, %d workers\n",
+           total, bytes / 1e6, num_windows, window, chunk, size - 1);
+    printf("Time = %f seconds, waiting on I/O = %f seconds\n", elapsed, wait_io);
+    printf("Sustained throughput: %.3f GB/s in, %.3f GB/s in + out\n",
+           bytes / elapsed / 1e9, 2 * bytes / elapsed / 1e9);
+    printf("Peak stream buffers on master = %.1f MB\n", 4.0 * window * sizeof(int) / 1e6);
+
+    free(in_buf[1]);
+    free(out_buf[1]);
+    long errors = verify_output(input, output, window, in_buf[0], out_buf[0]);
+    if (errors == VERIFY_UNREADABLE)
+        printf("Verification: FAILED (cannot reopen %s or %s)\n", input, output);
+    else if (errors == VERIFY_SHORT)
+        printf("Verification: FAILED (output shorter than input)\n");
+    else
+        printf("Verification: %s (%ld mismatches)\n", errors == 0 ? "passed" : "FAILED", errors);
+
+    free(in_buf[0]);
+    free(out_buf[0]);
+}
+
+// Worker: square chunks until told to stop; buffer is bounded by the chunk size
+static void worker(long chunk)
+{
+    int *segment = (int *)malloc(chunk * sizeof(int));
+    for (;;)
+    {
+        MPI_Status status;
+        int count;
+        MPI_Recv(segment, (int)chunk, MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        if (status.MPI_TAG == TAG_STOP)
+            break;
+
+        MPI_Get_count(&status, MPI_INT, &count);
+        for (int i = 0; i < count; i++)
+            segment[i] = segment[i] * segment[i];
+        MPI_Send(segment, count, MPI_INT, 0, TAG_RESULT, MPI_COMM_WORLD);
+    }
+    free(segment);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size;
+
+    // Initialize the MPI environment
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task1_stream gen <file> <count>
+    //        task1_stream <input> <output> [budget_mb] [chunk]
+    if (argc > 3 && strcmp(argv[1], "gen") == 0)
+    {
+        if (rank == 0)
+            generate_input(argv[2], atol(argv[3]));
+        MPI_Finalize();
+        return 0;
+    }
+    if (argc < 3 || size < 2)
+    {
+        if (rank == 0)
+            printf("Usage: task1_stream gen <file> <count> | task1_stream <input> <output> [budget_mb] [chunk] (2+ processes)\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    long budget = (argc > 3 ? atol(argv[3]) : DEFAULT_BUDGET_MB) * (1L << 20);
+    long chunk = argc > 4 ? atol(argv[4]) : DEFAULT_CHUNK;
+
+    // The master holds 4 windows (2 in, 2 out); a worker holds one chunk
+    long window = budget / (4 * (long)sizeof(int));
+    if (chunk > window)
+        chunk = window;
+    if (window <= 0 || chunk <= 0)
+    {
+        if (rank == 0)
+            printf("Error: memory budget too small.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    if (rank == 0)
+        master(size, argv[1], argv[2], window, chunk);
+    else
+        worker(chunk);
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+    return 0;
+}
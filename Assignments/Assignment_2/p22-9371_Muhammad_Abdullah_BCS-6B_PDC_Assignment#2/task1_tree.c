@@ -0,0 +1,261 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atol
+#include <mpi.h>    // For MPI functions
+
+#define DEFAULT_ARRAY_SIZE (1 << 22) // Total number of elements in the array
+#define DEFAULT_FANOUT 4             // Children per (sub-)master
+
+// Tree layout over ranks 0 .. size-1: node v has children v*F+1 .. v*F+F.
+// Numbering the nodes in preorder makes every subtree a contiguous range of
+// preorder positions, so each subtree's data is one contiguous array slice.
+typedef struct
+{
+    int *pre;     // Preorder position of each rank (root = 0)
+    int *subtree; // Number of ranks in each rank's subtree, itself included
+} Tree;
+
+static void tree_build(Tree *t, int size, int fanout)
+{
+    t->pre = (int *)malloc(size * sizeof(int));
+    t->subtree = (int *)malloc(size * sizeof(int));
+
+    // Subtree sizes bottom-up (children always have larger ranks)
+    for (int v = size - 1; v >= 0; v--)
+    {
+        t->subtree[v] = 1;
+        for (int c = v * fanout + 1; c <= v * fanout + fanout && c < size; c++)
+            t->subtree[v] += t->subtree[c];
+    }
+
+    // Preorder positions top-down: first child right after its parent
+    t->pre[0] = 0;
+    for (int v = 0; v < size; v++)
+    {
+        int next = t->pre[v] + 1;
+        for (int c = v * fanout + 1; c <= v * fanout + fanout && c < size; c++)
+        {
+            t->pre[c] = next;
+            next += t->subtree[c];
+        }
+    }
+}
+
+static void tree_free(Tree *t)
+{
+    free(t->pre);
+    free(t->subtree);
+}
+
+// Array offset of the worker at preorder position p (1 .. workers); the
+// remainder goes to the first positions, as in task1.c
+static long position_offset(long n, int workers, int p)
+{
+    long base = n / workers, remainder = n % workers;
+    return (p - 1) * base + ((p - 1) < remainder ? (p - 1) : remainder);
+}
+
+// Contiguous slice [offset, offset + count) covered by the subtree of v
+static void subtree_slice(const Tree *t, long n, int workers, int v, long *offset, long *count)
+{
+    int first = t->pre[v] == 0 ? 1 : t->pre[v]; // The root holds no data of its own
+    int last = t->pre[v] + t->subtree[v];       // One past the last position
+    *offset = position_offset(n, workers, first);
+    *count = position_offset(n, workers, last) - *offset;
+}
+
+// Flat master from task1.c: size then data to every worker, results back in order
+static void flat_farm(MPI_Comm comm, long n, int *array, int *result, double *distribute_time, double *collect_time)
+{
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    int workers = size - 1;
+    double t0, t1, t2, t3;
+
+    MPI_Barrier(comm);
+    t0 = MPI_Wtime();
+    int count = 0;
+    int *segment = NULL;
+    if (rank == 0)
+    {
+        for (int i = 1; i < size; i++)
+        {
+            long offset = position_offset(n, workers, i);
+            int send_size = (int)(position_offset(n, workers, i + 1) - offset);
+            MPI_Send(&send_size, 1, MPI_INT, i, 0, comm);
+            MPI_Send(&array[offset], send_size, MPI_INT, i, 0, comm);
+        }
+    }
+    else
+    {
+        MPI_Recv(&count, 1, MPI_INT, 0, 0, comm, MPI_STATUS_IGNORE);
+        segment = (int *)malloc(count * sizeof(int));
+        MPI_Recv(segment, count, MPI_INT, 0, 0, comm, MPI_STATUS_IGNORE);
+    }
+    MPI_Barrier(comm);
+    t1 = MPI_Wtime();
+
+    for (int i = 0; i < count; i++)
+        segment[i] = segment[i] * segment[i];
+
+    MPI_Barrier(comm);
+    t2 = MPI_Wtime();
+    if (rank == 0)
+    {
+        for (int i = 1; i < size; i++)
+        {
+            long offset = position_offset(n, workers, i);
+            int recv_size = (int)(position_offset(n, workers, i + 1) - offset);
+            MPI_Recv(&result[offset], recv_size, MPI_INT, i, 0, comm, MPI_STATUS_IGNORE);
+        }
+    }
+    else
+    {
+        MPI_Send(segment, count, MPI_INT, 0, 0, comm);
+    }
+    t3 = MPI_Wtime();
+
+    *distribute_time = t1 - t0;
+    *collect_time = t3 - t2;
+    free(segment);
+}
+
+// Tree master: each node receives its whole subtree's slice from its parent in
+// one message, keeps its own segment and forwards one slice per child. Results
+// are aggregated the same way on the way back up. A node only ever holds its
+// subtree's slice, so memory per rank shrinks with depth instead of being N.
+static void tree_farm(MPI_Comm comm, long n, int fanout, int *array, int *result, double *distribute_time,
+                      double *collect_time)
+{
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    int workers = size - 1;
+    Tree t;
+    tree_build(&t, size, fanout);
+    double t0, t1, t2, t3;
+
+    // Slice owned by this subtree; the root works on the whole array in place
+    long base, total;
+    subtree_slice(&t, n, workers, rank, &base, &total);
+    int *buffer = (rank == 0) ? NULL : (int *)malloc(total * sizeof(int));
+    int *data = (rank == 0) ? array : buffer;
+    int *out = (rank == 0) ? result : buffer;
+    long own = (rank == 0) ? 0 : position_offset(n, workers, t.pre[rank] + 1) - base;
+
+    MPI_Barrier(comm);
+    t0 = MPI_Wtime();
+    if (rank != 0)
+    {
+        int parent = (rank - 1) / fanout;
+        MPI_Recv(buffer, (int)total, MPI_INT, parent, 0, comm, MPI_STATUS_IGNORE);
+    }
+    for (int c = rank * fanout + 1; c <= rank * fanout + fanout && c < size; c++)
+    {
+        long offset, count;
+        subtree_slice(&t, n, workers, c, &offset, &count);
+        MPI_Send(&data[offset - base], (int)count, MPI_INT, c, 0, comm);
+    }
+    MPI_Barrier(comm);
+    t1 = MPI_Wtime();
+
+    for (long i = 0; i < own; i++)
+        buffer[i] = buffer[i] * buffer[i];
+
+    MPI_Barrier(comm);
+    t2 = MPI_Wtime();
+    for (int c = rank * fanout + 1; c <= rank * fanout + fanout && c < size; c++)
+    {
+        long offset, count;
+        subtree_slice(&t, n, workers, c, &offset, &count);
+        MPI_Recv(&out[offset - base], (int)count, MPI_INT, c, 0, comm, MPI_STATUS_IGNORE);
+    }
+    if (rank != 0)
+    {
+        int parent = (rank - 1) / fanout;
+        MPI_Send(buffer, (int)total, MPI_INT, parent, 0, comm);
+    }
+    t3 = MPI_Wtime();
+
+    *distribute_time = t1 - t0;
+    *collect_time = t3 - t2;
+    free(buffer);
+    tree_free(&t);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size;
+    long array_size = DEFAULT_ARRAY_SIZE; // Total elements in the main array
+    int fanout = DEFAULT_FANOUT;          // Children per node in the tree
+
+    // Initialize the MPI environment
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task1_tree [array_size] [fanout]
+    if (argc > 1)
+        array_size = atol(argv[1]);
+    if (argc > 2)
+        fanout = atoi(argv[2]);
+
+    if (size < 2 || fanout < 1 || array_size < size - 1)
+    {
+        if (rank == 0)
+            printf("Error: need 2+ processes, fanout >= 1 and one element per worker.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    int *array = NULL, *result = NULL;
+    if (rank == 0)
+    {
+        array = (int *)malloc(array_size * sizeof(int));
+        result = (int *)malloc(array_size * sizeof(int));
+        for (long i = 0; i < array_size; i++)
+            array[i] = (int)(i % 30000) + 1;
+        printf("Farm of %ld elements, tree fan-out %d\n", array_size, fanout);
+        printf("%6s %14s %14s %14s %14s %8s\n", "procs", "flat dist (s)", "flat coll (s)",
+               "tree dist (s)", "tree coll (s)", "errors");
+    }
+
+    // Scaling sweep over the first p processes, p = 2, 4, 8, ..., size
+    for (int p = 2; p <= size; p = (p * 2 > size && p != size) ? size : p * 2)
+    {
+        MPI_Comm sub;
+        MPI_Comm_split(MPI_COMM_WORLD, rank < p ? 0 : MPI_UNDEFINED, rank, &sub);
+        if (sub != MPI_COMM_NULL)
+        {
+            double flat_dist, flat_coll, tree_dist, tree_coll;
+            flat_farm(sub, array_size, array, result, &flat_dist, &flat_coll);
+            long errors = 0;
+            if (rank == 0)
+                for (long i = 0; i < array_size; i++)
+                {
+                    if (result[i] != array[i] * array[i])
+                        errors++;
+                    result[i] = 0; // So the tree run is checked on its own output
+                }
+
+            tree_farm(sub, array_size, fanout, array, result, &tree_dist, &tree_coll);
+            if (rank == 0)
+            {
+                for (long i = 0; i < array_size; i++)
+                    if (result[i] != array[i] * array[i])
+                        errors++;
+                printf("%6d %14f %14f %14f %14f %8ld\n", p, flat_dist, flat_coll, tree_dist, tree_coll, errors);
+            }
+            MPI_Comm_free(&sub);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    // Clean up
+    free(array);
+    free(result);
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,431 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atol
+#include <string.h> // For memcpy
+#include <mpi.h>    // For MPI functions
+
+#define DEFAULT_ARRAY_SIZE (1 << 18) // Total number of elements in the array
+#define DEFAULT_FLUSH_BYTES 16384    // Batch is sent once it holds this many bytes
+#define DEFAULT_DEADLINE_US 200      // ... or once its oldest frame has waited this long
+#define MAX_CHUNK 1024               // Largest chunk in the sweep (elements)
+#define TAG_SIZE 1                   // Two-message protocol: segment size
+#define TAG_DATA 2                   // Two-message protocol: segment data
+#define TAG_FRAME 3                  // Framed protocol: one or more frames
+
+enum
+{
+    TWO_MESSAGE,
+    FRAMED,
+    COALESCED,
+    NUM_MODES
+};
+static const char *mode_names[NUM_MODES] = {"size + data", "framed", "framed + coalesced"};
+
+// Header in front of every payload; count < 0 marks the end of a stream
+typedef struct
+{
+    long long offset; // Position of the payload in the global array
+    int count;        // Ints that follow the header
+    int pad;
+} FrameHeader;
+
+// Sends still in flight; their buffers are freed once MPI is done with them.
+// Nothing ever blocks on a send, so two peers flushing large batches at each
+// other cannot deadlock.
+typedef struct
+{
+    MPI_Request *requests;
+    char **buffers;
+    int count, capacity;
+    long long messages; // Sends issued, for the report
+} Outbox;
+
+// Frames waiting to go to one peer
+typedef struct
+{
+    char *data;
+    long used, capacity;
+    double first_time; // When the oldest frame was added
+    int peer;
+} Batch;
+
+static void outbox_reap(Outbox *o, int wait)
+{
+    if (wait)
+        MPI_Waitall(o->count, o->requests, MPI_STATUSES_IGNORE);
+    int kept = 0;
+    for (int i = 0; i < o->count; i++)
+    {
+        int done = 1;
+        if (!wait)
+            MPI_Test(&o->requests[i], &done, MPI_STATUS_IGNORE);
+        if (done)
+            free(o->buffers[i]);
+        else
+        {
+            o->requests[kept] = o->requests[i];
+            o->buffers[kept++] = o->buffers[i];
+        }
+    }
+    o->count = kept;
+}
+
+// Hand a filled buffer to MPI; ownership passes to the outbox
+static void outbox_send(Outbox *o, char *buffer, long bytes, int peer)
+{
+    if (o->count == o->capacity)
+    {
+        outbox_reap(o, 0);
+        if (o->count == o->capacity)
+        {
+            o->capacity = o->capacity ? o->capacity * 2 : 64;
+            o->requests = (MPI_Request *)realloc(o->requests, o->capacity * sizeof(MPI_Request));
+            o->buffers = (char **)realloc(o->buffers, o->capacity * sizeof(char *));
+        }
+    }
+    MPI_Isend(buffer, (int)bytes, MPI_BYTE, peer, TAG_FRAME, MPI_COMM_WORLD, &o->requests[o->count]);
+    o->buffers[o->count++] = buffer;
+    o->messages++;
+}
+
+static void batch_flush(Batch *b, Outbox *o)
+{
+    if (b->used == 0)
+        return;
+    outbox_send(o, b->data, b->used, b->peer);
+    b->data = NULL;
+    b->used = b->capacity = 0;
+}
+
+// Append one frame; send the batch when it reaches flush_bytes (0 = every frame)
+static void batch_append(Batch *b, Outbox *o, long long offset, int count, const int *payload, long flush_bytes)
+{
+    long bytes = sizeof(FrameHeader) + (count > 0 ? count : 0) * sizeof(int);
+    if (b->used + bytes > b->capacity)
+    {
+        b->capacity = (b->used + bytes > flush_bytes ? b->used + bytes : flush_bytes) * 2;
+        b->data = (char *)realloc(b->data, b->capacity);
+    }
+    if (b->used == 0)
+        b->first_time = MPI_Wtime();
+
+    FrameHeader header = {offset, count, 0};
+    memcpy(b->data + b->used, &header, sizeof(header));
+    if (count > 0)
+        memcpy(b->data + b->used + sizeof(header), payload, count * sizeof(int));
+    b->used += bytes;
+
+    if (b->used >= flush_bytes)
+        batch_flush(b, o);
+}
+
+// Send the batch if its oldest frame is past the deadline
+static void batch_poll(Batch *b, Outbox *o, double deadline)
+{
+    if (b->used > 0 && MPI_Wtime() - b->first_time >= deadline)
+        batch_flush(b, o);
+}
+
+// Receive one framed message of whatever size, growing the buffer to fit.
+// MPI_Mprobe hands us exactly the probed message, so no size message and no
+// fixed maximum are needed, and other threads or probes cannot steal it.
+static long receive_frames(MPI_Message *message, MPI_Status *status, char **buffer, long *capacity)
+{
+    int bytes;
+    MPI_Get_count(status, MPI_BYTE, &bytes);
+    if (bytes > *capacity)
+    {
+        *capacity = bytes;
+        *buffer = (char *)realloc(*buffer, bytes);
+    }
+    MPI_Mrecv(*buffer, bytes, MPI_BYTE, message, MPI_STATUS_IGNORE);
+    return bytes;
+}
+
+// Walk the frames of a message; returns ints delivered, sets *ended on an end frame
+static long for_each_frame(char *buffer, long bytes, int *ended, void (*visit)(FrameHeader *, int *, void *),
+                           void *context)
+{
+    long delivered = 0;
+    for (long pos = 0; pos < bytes;)
+    {
+        FrameHeader header;
+        memcpy(&header, buffer + pos, sizeof(header));
+        pos += sizeof(header);
+        if (header.count < 0)
+        {
+            *ended = 1;
+            continue;
+        }
+        visit(&header, (int *)(buffer + pos), context);
+        pos += header.count * sizeof(int);
+        delivered += header.count;
+    }
+    return delivered;
+}
+
+// Master side: copy a returned payload into place
+static void store_result(FrameHeader *header, int *payload, void *context)
+{
+    memcpy((int *)context + header->offset, payload, header->count * sizeof(int));
+}
+
+// Worker side: square the payload and queue it back to the master
+typedef struct
+{
+    Batch *batch;
+    Outbox *outbox;
+    long flush_bytes;
+    double deadline;
+} Reply;
+
+static void square_and_reply(FrameHeader *header, int *payload, void *context)
+{
+    Reply *reply = (Reply *)context;
+    for (int i = 0; i < header->count; i++)
+        payload[i] = payload[i] * payload[i];
+    batch_append(reply->batch, reply->outbox, header->offset, header->count, payload, reply->flush_bytes);
+    batch_poll(reply->batch, reply->outbox, reply->deadline);
+}
+
+// Baseline from task1.c/task2.c: every chunk is a size message plus a data
+// message, in both directions. Chunk i goes to worker i % workers + 1, and
+// per-pair ordering tells the master where each reply belongs.
+static long long run_two_message(int rank, int size, long n, int chunk, const int *array, int *result)
+{
+    int workers = size - 1;
+    long chunks = (n + chunk - 1) / chunk;
+    long long messages = 0;
+    int buffer[MAX_CHUNK];
+
+    if (rank == 0)
+    {
+        long next_reply[size]; // Index of the next chunk each worker will return
+        for (int w = 1; w < size; w++)
+            next_reply[w] = w - 1;
+        long received = 0;
+
+        // One extra round after the last chunk sends the end markers
+        for (long c = 0; c <= chunks; c++)
+        {
+            if (c < chunks)
+            {
+                int w = (int)(c % workers) + 1;
+                int count = (int)((c + 1) * chunk <= n ? chunk : n - c * chunk);
+                MPI_Send(&count, 1, MPI_INT, w, TAG_SIZE, MPI_COMM_WORLD);
+                MPI_Send(&array[c * chunk], count, MPI_INT, w, TAG_DATA, MPI_COMM_WORLD);
+                messages += 2;
+            }
+            else
+            {
+                int end = -1;
+                for (int w = 1; w < size; w++)
+                    MPI_Send(&end, 1, MPI_INT, w, TAG_SIZE, MPI_COMM_WORLD);
+                messages += workers;
+            }
+
+            // Drain replies as they come; block for the rest once everything is sent
+            int flag = 1;
+            while (received < n && flag)
+            {
+                MPI_Status status;
+                if (c < chunks)
+                    MPI_Iprobe(MPI_ANY_SOURCE, TAG_SIZE, MPI_COMM_WORLD, &flag, &status);
+                else
+                    MPI_Probe(MPI_ANY_SOURCE, TAG_SIZE, MPI_COMM_WORLD, &status);
+                if (!flag)
+                    break;
+                int w = status.MPI_SOURCE, count;
+                MPI_Recv(&count, 1, MPI_INT, w, TAG_SIZE, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                MPI_Recv(&result[next_reply[w] * chunk], count, MPI_INT, w, TAG_DATA, MPI_COMM_WORLD,
+                         MPI_STATUS_IGNORE);
+                next_reply[w] += workers;
+                received += count;
+            }
+        }
+    }
+    else
+    {
+        for (;;)
+        {
+            int count;
+            MPI_Recv(&count, 1, MPI_INT, 0, TAG_SIZE, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            if (count < 0)
+                break;
+            MPI_Recv(buffer, count, MPI_INT, 0, TAG_DATA, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            for (int i = 0; i < count; i++)
+                buffer[i] = buffer[i] * buffer[i];
+            MPI_Send(&count, 1, MPI_INT, 0, TAG_SIZE, MPI_COMM_WORLD);
+            MPI_Send(buffer, count, MPI_INT, 0, TAG_DATA, MPI_COMM_WORLD);
+            messages += 2;
+        }
+    }
+    return messages;
+}
+
+// Framed protocol; flush_bytes = 0 sends every frame on its own
+static long long run_framed(int rank, int size, long n, int chunk, const int *array, int *result,
+                            long flush_bytes, double deadline)
+{
+    int workers = size - 1;
+    long chunks = (n + chunk - 1) / chunk;
+    Outbox outbox = {NULL, NULL, 0, 0, 0};
+    char *in = NULL;
+    long in_capacity = 0;
+    MPI_Message message;
+    MPI_Status status;
+    int flag, ended = 0;
+
+    if (rank == 0)
+    {
+        Batch batches[size];
+        for (int w = 0; w < size; w++)
+        {
+            Batch empty = {NULL, 0, 0, 0, w};
+            batches[w] = empty;
+        }
+
+        long received = 0;
+        for (long c = 0; c < chunks; c++)
+        {
+            int w = (int)(c % workers) + 1;
+            int count = (int)((c + 1) * chunk <= n ? chunk : n - c * chunk);
+            batch_append(&batches[w], &outbox, c * chunk, count, &array[c * chunk], flush_bytes);
+
+            // Consume replies that have already arrived, and honour deadlines
+            MPI_Improbe(MPI_ANY_SOURCE, TAG_FRAME, MPI_COMM_WORLD, &flag, &message, &status);
+            while (flag)
+            {
+                long bytes = receive_frames(&message, &status, &in, &in_capacity);
+                received += for_each_frame(in, bytes, &ended, store_result, result);
+                MPI_Improbe(MPI_ANY_SOURCE, TAG_FRAME, MPI_COMM_WORLD, &flag, &message, &status);
+            }
+            for (int p = 1; p < size; p++)
+                batch_poll(&batches[p], &outbox, deadline);
+        }
+
+        // End-of-stream frame rides in the last batch to each worker
+        for (int p = 1; p < size; p++)
+        {
+            batch_append(&batches[p], &outbox, 0, -1, NULL, flush_bytes);
+            batch_flush(&batches[p], &outbox);
+        }
+        while (received < n)
+        {
+            MPI_Mprobe(MPI_ANY_SOURCE, TAG_FRAME, MPI_COMM_WORLD, &message, &status);
+            long bytes = receive_frames(&message, &status, &in, &in_capacity);
+            received += for_each_frame(in, bytes, &ended, store_result, result);
+        }
+    }
+    else
+    {
+        Batch batch = {NULL, 0, 0, 0, 0};
+        Reply reply = {&batch, &outbox, flush_bytes, deadline};
+        while (!ended)
+        {
+            // Flush early whenever no more input is waiting, so replies never stall
+            MPI_Improbe(0, TAG_FRAME, MPI_COMM_WORLD, &flag, &message, &status);
+            if (!flag)
+            {
+                batch_flush(&batch, &outbox);
+                MPI_Mprobe(0, TAG_FRAME, MPI_COMM_WORLD, &message, &status);
+            }
+            long bytes = receive_frames(&message, &status, &in, &in_capacity);
+            for_each_frame(in, bytes, &ended, square_and_reply, &reply);
+        }
+        batch_flush(&batch, &outbox);
+        free(batch.data);
+    }
+
+    outbox_reap(&outbox, 1);
+    free(outbox.requests);
+    free(outbox.buffers);
+    free(in);
+    return outbox.messages;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size;
+    long array_size = DEFAULT_ARRAY_SIZE;  // Total elements in the main array
+    long flush_bytes = DEFAULT_FLUSH_BYTES; // Batch size that triggers a send
+    double deadline_us = DEFAULT_DEADLINE_US;
+
+    // Initialize the MPI environment
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task2_framed [array_size] [flush_bytes] [deadline_us]
+    if (argc > 1)
+        array_size = atol(argv[1]);
+    if (argc > 2)
+        flush_bytes = atol(argv[2]);
+    if (argc > 3)
+        deadline_us = atof(argv[3]);
+
+    if (size < 2 || array_size <= 0 || flush_bytes <= 0 || deadline_us < 0)
+    {
+        if (rank == 0)
+            printf("Error: need 2+ processes and positive sizes.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    int *array = NULL, *result = NULL;
+    if (rank == 0)
+    {
+        array = (int *)malloc(array_size * sizeof(int));
+        result = (int *)malloc(array_size * sizeof(int));
+        for (long i = 0; i < array_size; i++)
+            array[i] = (int)(i % 30000) + 1;
+        printf("Fine-grained farm of %ld elements, %d workers, batches of %ld bytes or %.0f us\n",
+               array_size, size - 1, flush_bytes, deadline_us);
+        printf("%8s %-20s %12s %12s %14s %9s %8s\n", "chunk", "protocol", "time (s)", "messages",
+               "chunks/s", "speedup", "errors");
+    }
+
+    for (int chunk = 1; chunk <= MAX_CHUNK; chunk *= 4)
+    {
+        double baseline = 0;
+        for (int mode = 0; mode < NUM_MODES; mode++)
+        {
+            if (rank == 0)
+                for (long i = 0; i < array_size; i++)
+                    result[i] = 0;
+
+            MPI_Barrier(MPI_COMM_WORLD);
+            double start_time = MPI_Wtime();
+            long long messages;
+            if (mode == TWO_MESSAGE)
+                messages = run_two_message(rank, size, array_size, chunk, array, result);
+            else
+                messages = run_framed(rank, size, array_size, chunk, array, result,
+                                      mode == FRAMED ? 0 : flush_bytes, deadline_us * 1e-6);
+            MPI_Barrier(MPI_COMM_WORLD);
+            double elapsed = MPI_Wtime() - start_time;
+
+            long long total_messages;
+            MPI_Reduce(&messages, &total_messages, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+            if (rank == 0)
+            {
+                long errors = 0;
+                for (long i = 0; i < array_size; i++)
+                    if (result[i] != array[i] * array[i])
+                        errors++;
+                if (mode == TWO_MESSAGE)
+                    baseline = elapsed;
+                long chunks = (array_size + chunk - 1) / chunk;
+                printf("%8d %-20s %12.6f %12lld %14.0f %8.2fx %8ld\n", chunk, mode_names[mode], elapsed,
+                       total_messages, chunks / elapsed, baseline / elapsed, errors);
+            }
+        }
+    }
+
+    // Clean up
+    free(array);
+    free(result);
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include <stdio.h>     // For input/output functions
+#include <stdlib.h>    // For malloc and atol
+#include <pthread.h>   // For the progress thread
+#include <stdatomic.h> // For the stop flag shared with the progress thread
+#include <time.h>      // For nanosleep
+#include <mpi.h>       // For MPI functions
+
+#define DEFAULT_SEGMENT_SIZE (4 << 20) // Ints sent to each worker (large enough for rendezvous)
+#define COMPUTE_SIZE (1 << 18)         // Doubles touched by the compute kernel per pass
+#define POLL_INTERVAL_US 50            // Sleep between MPI_Testall calls in the progress thread
+
+enum
+{
+    PROGRESS_OFF,    // Requests only advance inside MPI_Waitall (task2.c behaviour)
+    PROGRESS_POLL,   // Compute loop calls MPI_Testall between chunks
+    PROGRESS_THREAD, // Dedicated thread calls MPI_Testall while compute runs
+};
+
+static const char *mode_names[] = {"off", "poll", "thread"};
+
+// State shared with the progress thread
+typedef struct
+{
+    MPI_Request *requests; // Outstanding requests to drive
+    int count;             // Number of requests
+    atomic_int stop;       // Set by the main thread once compute is done
+    int completed;         // Set by the progress thread when everything finished; read after the join
+} ProgressEngine;
+
+static void *progress_thread(void *arg)
+{
+    ProgressEngine *engine = (ProgressEngine *)arg;
+    struct timespec pause = {0, POLL_INTERVAL_US * 1000};
+    int flag = 0;
+
+    while (!atomic_load(&engine->stop) && !flag)
+    {
+        MPI_Testall(engine->count, engine->requests, &flag, MPI_STATUSES_IGNORE);
+        if (!flag)
+            nanosleep(&pause, NULL);
+    }
+    engine->completed = flag;
+    return NULL;
+}
+
+// Synthetic user compute: `passes` sweeps over a buffer. In poll mode the
+// outstanding requests are tested after every sweep so the transfer keeps moving.
+static double compute(double *work, int passes, int mode, MPI_Request *requests, int count)
+{
+    int done = (count == 0);
+    for (int p = 0; p < passes; p++)
+    {
+        for (int i = 0; i < COMPUTE_SIZE; i++)
+            work[i] = work[i] * 0.999 + 1.0;
+
+        if (mode == PROGRESS_POLL && !done)
+            MPI_Testall(count, requests, &done, MPI_STATUSES_IGNORE);
+    }
+    return work[0];
+}
+
+// One round: master sends a segment to every worker and every rank computes
+// while the transfer is outstanding. Returns the barrier-to-barrier time.
+static double run_round(int rank, int size, int *array, int *segment, long segment_size,
+                        double *work, int passes, int mode, int do_transfer)
+{
+    int count = 0;
+    MPI_Request requests[size];
+    ProgressEngine engine = {requests, 0, 0, 0};
+    pthread_t thread;
+    double start_time, end_time;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+
+    if (do_transfer)
+    {
+        if (rank == 0)
+        {
+            // Non-blocking send of each worker's segment
+            for (int i = 1; i < size; i++)
+                MPI_Isend(&array[(i - 1) * segment_size], (int)segment_size, MPI_INT, i, 0,
+                          MPI_COMM_WORLD, &requests[count++]);
+        }
+        else
+        {
+            // Non-blocking receive of this worker's segment
+            MPI_Irecv(segment, (int)segment_size, MPI_INT, 0, 0, MPI_COMM_WORLD, &requests[count++]);
+        }
+    }
+
+    engine.count = count;
+    if (mode == PROGRESS_THREAD && count > 0)
+        pthread_create(&thread, NULL, progress_thread, &engine);
+
+    compute(work, passes, mode, requests, count);
+
+    if (mode == PROGRESS_THREAD && count > 0)
+    {
+        atomic_store(&engine.stop, 1);
+        pthread_join(thread, NULL);
+    }
+
+    // Completes whatever is still outstanding (everything, when the engine is off)
+    if (!engine.completed)
+        MPI_Waitall(count, requests, MPI_STATUSES_IGNORE);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    end_time = MPI_Wtime();
+    return end_time - start_time;
+}
+
+// Best of several rounds, to filter out scheduling noise
+static double best_round(int reps, int rank, int size, int *array, int *segment, long segment_size,
+                         double *work, int passes, int mode, int do_transfer)
+{
+    double best = 0;
+    for (int r = 0; r < reps; r++)
+    {
+        double t = run_round(rank, size, array, segment, segment_size, work, passes, mode, do_transfer);
+        if (r == 0 || t < best)
+            best = t;
+    }
+    return best;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size, provided;
+    long segment_size = DEFAULT_SEGMENT_SIZE; // Ints per worker
+    int passes = 200;                          // Compute sweeps per round
+    int reps = 5;                              // Rounds per measurement
+
+    // The progress thread calls MPI concurrently with the main thread
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task2_progress [segment_size] [compute_passes] [reps]
+    if (argc > 1)
+        segment_size = atol(argv[1]);
+    if (argc > 2)
+        passes = atoi(argv[2]);
+    if (argc > 3)
+        reps = atoi(argv[3]);
+
+    if (size < 2 || segment_size <= 0 || passes < 0 || reps <= 0)
+    {
+        if (rank == 0)
+            printf("Error: need at least 2 processes, a positive segment size, compute passes >= 0 and reps >= 1.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    int *array = NULL;
+    int *segment = NULL;
+    if (rank == 0)
+    {
+        array = (int *)malloc((size - 1) * segment_size * sizeof(int));
+        for (long i = 0; i < (size - 1) * segment_size; i++)
+            array[i] = (int)(i + 1);
+    }
+    else
+    {
+        segment = (int *)malloc(segment_size * sizeof(int));
+    }
+    double *work = (double *)calloc(COMPUTE_SIZE, sizeof(double));
+
+    // Reference times: transfer alone and compute alone
+    double transfer_time = best_round(reps, rank, size, array, segment, segment_size, work, 0, PROGRESS_OFF, 1);
+    double compute_time = best_round(reps, rank, size, array, segment, segment_size, work, passes, PROGRESS_OFF, 0);
+
+    if (rank == 0)
+    {
+        printf("Segment: %ld ints per worker (%.1f MB), %d processes\n",
+               segment_size, segment_size * sizeof(int) / 1e6, size);
+        printf("Transfer only: %f seconds, compute only: %f seconds\n", transfer_time, compute_time);
+    }
+
+    int last_mode = (provided == MPI_THREAD_MULTIPLE) ? PROGRESS_THREAD : PROGRESS_POLL;
+    if (rank == 0 && last_mode != PROGRESS_THREAD)
+        printf("MPI_THREAD_MULTIPLE not available, skipping the progress thread\n");
+
+    for (int mode = PROGRESS_OFF; mode <= last_mode; mode++)
+    {
+        double total = best_round(reps, rank, size, array, segment, segment_size, work, passes, mode, 1);
+
+        // Fraction of the shorter phase hidden behind the longer one
+        double hideable = transfer_time < compute_time ? transfer_time : compute_time;
+        double overlap = (transfer_time + compute_time - total) / hideable;
+        if (overlap < 0)
+            overlap = 0;
+        if (overlap > 1)
+            overlap = 1;
+
+        if (rank == 0)
+            printf("Progress %-6s: transfer + compute = %f seconds, overlap = %.0f%%\n",
+                   mode_names[mode], total, overlap * 100);
+    }
+
+    // Check that the last transfer arrived intact
+    if (rank != 0 && (segment[0] != (rank - 1) * segment_size + 1 ||
+                      segment[segment_size - 1] != rank * segment_size))
+        printf("Process %d: received segment is corrupted\n", rank);
+
+    // Clean up
+    free(array);
+    free(segment);
+    free(work);
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atoi
+#include <string.h> // For strcmp
+#include <mpi.h>    // For MPI functions
+
+#define MAX_DEGREE 64 // Upper bound on in/out edges per process
+
+// Neighbour lists of this process. Block i of a send buffer goes to
+// destinations[i]; block j of a receive buffer comes from sources[j].
+typedef struct
+{
+    int sources[MAX_DEGREE], destinations[MAX_DEGREE];
+    int indegree, outdegree;
+} Neighbors;
+
+// Ring from task4.c: send to next and prev, receive from prev and next
+static void ring_neighbors(int rank, int size, Neighbors *nb)
+{
+    int next = (rank + 1) % size;        // Next process in ring
+    int prev = (rank - 1 + size) % size; // Previous process in ring (wrap around)
+    nb->outdegree = nb->indegree = 2;
+    nb->destinations[0] = next;
+    nb->destinations[1] = prev;
+    nb->sources[0] = prev;
+    nb->sources[1] = next;
+}
+
+// Periodic 2D torus over the dimensions chosen by MPI_Dims_create
+static void torus_neighbors(int rank, int size, Neighbors *nb)
+{
+    int dims[2] = {0, 0};
+    MPI_Dims_create(size, 2, dims);
+    int row = rank / dims[1], col = rank % dims[1];
+    int right = row * dims[1] + (col + 1) % dims[1];
+    int left = row * dims[1] + (col - 1 + dims[1]) % dims[1];
+    int down = ((row + 1) % dims[0]) * dims[1] + col;
+    int up = ((row - 1 + dims[0]) % dims[0]) * dims[1] + col;
+
+    nb->outdegree = nb->indegree = 4;
+    int destinations[4] = {right, left, down, up};
+    int sources[4] = {left, right, up, down}; // Who sends me their right/left/down/up block
+    for (int i = 0; i < 4; i++)
+    {
+        nb->destinations[i] = destinations[i];
+        nb->sources[i] = sources[i];
+    }
+}
+
+// User-supplied directed graph: one "from to" edge per line. Fails if this
+// process has more than MAX_DEGREE edges either way; dropping the extras would
+// leave its peers expecting messages that never come.
+static int file_neighbors(const char *path, int rank, int size, Neighbors *nb)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return 0;
+
+    int from, to;
+    nb->indegree = nb->outdegree = 0;
+    while (fscanf(file, "%d %d", &from, &to) == 2)
+    {
+        if (from < 0 || from >= size || to < 0 || to >= size)
+            continue;
+        if ((from == rank && nb->outdegree == MAX_DEGREE) || (to == rank && nb->indegree == MAX_DEGREE))
+        {
+            fclose(file);
+            return 0;
+        }
+        if (from == rank)
+            nb->destinations[nb->outdegree++] = to;
+        if (to == rank)
+            nb->sources[nb->indegree++] = from;
+    }
+    fclose(file);
+    return 1;
+}
+
+// Number of earlier entries in list equal to list[index]; used as the tag so
+// repeated edges between the same pair match in order, like the collective
+static int occurrence(const int *list, int index)
+{
+    int count = 0;
+    for (int i = 0; i < index; i++)
+        if (list[i] == list[index])
+            count++;
+    return count;
+}
+
+// Hand-coded version of MPI_Neighbor_alltoall, as task4_b.c does per neighbour
+static void manual_alltoall(const Neighbors *nb, int *send, int *recv, int count, MPI_Comm comm)
+{
+    MPI_Request requests[2 * MAX_DEGREE];
+    int req_index = 0;
+    for (int j = 0; j < nb->indegree; j++)
+        MPI_Irecv(&recv[j * count], count, MPI_INT, nb->sources[j], occurrence(nb->sources, j),
+                  comm, &requests[req_index++]);
+    for (int i = 0; i < nb->outdegree; i++)
+        MPI_Isend(&send[i * count], count, MPI_INT, nb->destinations[i], occurrence(nb->destinations, i),
+                  comm, &requests[req_index++]);
+    MPI_Waitall(req_index, requests, MPI_STATUSES_IGNORE);
+}
+
+// Count received blocks whose contents do not name the expected source
+static int check_blocks(const Neighbors *nb, const int *recv, int count)
+{
+    int errors = 0;
+    for (int j = 0; j < nb->indegree; j++)
+        if (recv[(long)j * count] != nb->sources[j] || recv[(long)j * count + count - 1] != nb->sources[j])
+            errors++;
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size;
+    const char *topology = "ring"; // ring, torus or a graph file
+    int max_count = 1 << 16;       // Largest block (ints per neighbour) in the sweep
+    int iterations = 100;          // Exchanges per measurement
+
+    // Initialize the MPI environment
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task4_neighbor [ring|torus|graph_file] [max_ints_per_neighbor] [iterations]
+    if (argc > 1)
+        topology = argv[1];
+    if (argc > 2)
+        max_count = atoi(argv[2]);
+    if (argc > 3)
+        iterations = atoi(argv[3]);
+
+    Neighbors nb;
+    int ok = 1;
+    if (strcmp(topology, "ring") == 0)
+        ring_neighbors(rank, size, &nb);
+    else if (strcmp(topology, "torus") == 0)
+        torus_neighbors(rank, size, &nb);
+    else
+        ok = file_neighbors(topology, rank, size, &nb);
+
+    int all_ok;
+    MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (max_count <= 0 || iterations <= 0)
+    {
+        if (rank == 0)
+            printf("Error: ints per neighbour and iterations must be positive.\n");
+        MPI_Finalize();
+        return 1;
+    }
+    if (!all_ok)
+    {
+        if (rank == 0)
+            printf("Error: '%s' is not ring, torus or a readable graph file with at most %d in/out edges per process.\n",
+                   topology, MAX_DEGREE);
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Describe the graph once; MPI may reorder ranks to match the hardware,
+    // but we keep the original numbering so the neighbour lists stay valid.
+    // Equal explicit weights mean the same as MPI_UNWEIGHTED.
+    MPI_Comm graph;
+    int weights[MAX_DEGREE];
+    for (int i = 0; i < MAX_DEGREE; i++)
+        weights[i] = 1;
+    MPI_Dist_graph_create_adjacent(MPI_COMM_WORLD, nb.indegree, nb.sources, weights,
+                                   nb.outdegree, nb.destinations, weights,
+                                   MPI_INFO_NULL, 0, &graph);
+
+    int *send = (int *)malloc((long)(nb.outdegree > 0 ? nb.outdegree : 1) * max_count * sizeof(int));
+    int *recv = (int *)malloc((long)(nb.indegree > 0 ? nb.indegree : 1) * max_count * sizeof(int));
+    int *gathered = (int *)malloc((nb.indegree > 0 ? nb.indegree : 1) * sizeof(int));
+
+    // Allgather flavour: every process learns one value from each in-neighbour
+    MPI_Neighbor_allgather(&rank, 1, MPI_INT, gathered, 1, MPI_INT, graph);
+    int errors = 0;
+    for (int j = 0; j < nb.indegree; j++)
+        if (gathered[j] != nb.sources[j])
+            errors++;
+
+    if (rank == 0)
+    {
+        printf("Topology %s on %d processes (process 0: %d in, %d out edges)\n",
+               topology, size, nb.indegree, nb.outdegree);
+        printf("%10s %16s %16s %8s\n", "ints/edge", "manual (us)", "neighbor (us)", "speedup");
+    }
+
+    for (int count = 1; count <= max_count; count *= 8)
+    {
+        // Block for destination i is tagged with this rank, so receivers can check the source
+        for (int i = 0; i < nb.outdegree; i++)
+            for (int k = 0; k < count; k++)
+                send[(long)i * count + k] = rank;
+
+        double start_time, manual_time, neighbor_time;
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        start_time = MPI_Wtime();
+        for (int it = 0; it < iterations; it++)
+            manual_alltoall(&nb, send, recv, count, MPI_COMM_WORLD);
+        MPI_Barrier(MPI_COMM_WORLD);
+        manual_time = (MPI_Wtime() - start_time) / iterations;
+        errors += check_blocks(&nb, recv, count);
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        start_time = MPI_Wtime();
+        for (int it = 0; it < iterations; it++)
+            MPI_Neighbor_alltoall(send, count, MPI_INT, recv, count, MPI_INT, graph);
+        MPI_Barrier(MPI_COMM_WORLD);
+        neighbor_time = (MPI_Wtime() - start_time) / iterations;
+
+        errors += check_blocks(&nb, recv, count);
+
+        if (rank == 0)
+            printf("%10d %16.2f %16.2f %7.2fx\n", count, manual_time * 1e6, neighbor_time * 1e6,
+                   manual_time / neighbor_time);
+    }
+
+    int total_errors;
+    MPI_Reduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    if (rank == 0)
+        printf("Blocks from the wrong source: %d\n", total_errors);
+
+    // Clean up
+    free(send);
+    free(recv);
+    free(gathered);
+    MPI_Comm_free(&graph);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atol
+#include <math.h>   // For fabs
+#include <mpi.h>    // For MPI functions
+
+#define ALPHA 0.25 // Diffusion coefficient (stable for <= 0.5)
+
+// One explicit heat-diffusion step over [begin, end) of the local array
+static void diffuse(const double *u, double *v, long begin, long end)
+{
+    for (long i = begin; i < end; i++)
+        v[i] = u[i] + ALPHA * (u[i - 1] - 2.0 * u[i] + u[i + 1]);
+}
+
+// Initial condition: hot band in the middle tenth of the global domain
+static double initial_value(long g, long global_n)
+{
+    return (g >= global_n / 2 - global_n / 20 && g < global_n / 2 + global_n / 20) ? 1.0 : 0.0;
+}
+
+// Single-process periodic run with one ghost per side, for checking the
+// distributed runs cell by cell; result goes to out[0 .. global_n)
+static void serial_reference(long global_n, long steps, double *out)
+{
+    double *u = (double *)malloc((global_n + 2) * sizeof(double));
+    double *v = (double *)malloc((global_n + 2) * sizeof(double));
+    for (long g = 0; g < global_n; g++)
+        u[g + 1] = initial_value(g, global_n);
+    for (long step = 0; step < steps; step++)
+    {
+        u[0] = u[global_n];
+        u[global_n + 1] = u[1];
+        diffuse(u, v, 1, global_n + 1);
+        double *t = u;
+        u = v;
+        v = t;
+    }
+    for (long g = 0; g < global_n; g++)
+        out[g] = u[g + 1];
+    free(u);
+    free(v);
+}
+
+// Post the ghost-cell exchange with the ring neighbours from task4.c. The
+// local array is [halo ghosts | n owned cells | halo ghosts].
+static void post_halo(double *u, long n, int halo, int prev, int next, MPI_Comm comm, MPI_Request *requests)
+{
+    MPI_Irecv(&u[0], halo, MPI_DOUBLE, prev, 0, comm, &requests[0]);
+    MPI_Irecv(&u[n + halo], halo, MPI_DOUBLE, next, 1, comm, &requests[1]);
+    MPI_Isend(&u[n], halo, MPI_DOUBLE, next, 0, comm, &requests[2]);
+    MPI_Isend(&u[halo], halo, MPI_DOUBLE, prev, 1, comm, &requests[3]);
+}
+
+// Run `steps` steps on a ring of the processes in comm. With a halo of width h
+// the ghosts are exchanged once every h steps: step s of a block updates
+// [s + 1, n + 2h - s - 1), so the valid region shrinks back to the owned cells.
+// When overlap is on, the first step of each block updates the cells that do
+// not touch the ghosts while the exchange is in flight.
+// Returns the elapsed time; *heat receives the global sum of the owned cells,
+// and when collect is set the final owned cells are gathered into field on rank 0.
+static double run_stencil(MPI_Comm comm, long n, long steps, int halo, int overlap, double *heat, int collect,
+                          double *field)
+{
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    int next = (rank + 1) % size;        // Next process in ring
+    int prev = (rank - 1 + size) % size; // Previous process in ring (wrap around)
+    long total = n + 2 * halo;
+
+    double *u = (double *)calloc(total, sizeof(double));
+    double *v = (double *)calloc(total, sizeof(double));
+
+    long global_n = n * size;
+    for (long i = 0; i < n; i++)
+        u[halo + i] = initial_value(rank * n + i, global_n);
+
+    MPI_Request requests[4];
+    double start_time, end_time;
+    MPI_Barrier(comm);
+    start_time = MPI_Wtime();
+
+    for (long step = 0; step < steps; step += halo)
+    {
+        post_halo(u, n, halo, prev, next, comm, requests);
+
+        if (overlap)
+        {
+            // Interior of the first step only reads owned cells
+            diffuse(u, v, halo + 1, n + halo - 1);
+            MPI_Waitall(4, requests, MPI_STATUSES_IGNORE);
+            diffuse(u, v, 1, halo + 1);
+            diffuse(u, v, n + halo - 1, total - 1);
+        }
+        else
+        {
+            MPI_Waitall(4, requests, MPI_STATUSES_IGNORE);
+            diffuse(u, v, 1, total - 1);
+        }
+        double *t = u;
+        u = v;
+        v = t;
+
+        // Remaining steps of the block run on the shrinking ghost region
+        for (int s = 1; s < halo && step + s < steps; s++)
+        {
+            diffuse(u, v, s + 1, total - s - 1);
+            t = u;
+            u = v;
+            v = t;
+        }
+    }
+
+    MPI_Barrier(comm);
+    end_time = MPI_Wtime();
+
+    double local_heat = 0;
+    for (long i = halo; i < n + halo; i++)
+        local_heat += u[i];
+    MPI_Allreduce(&local_heat, heat, 1, MPI_DOUBLE, MPI_SUM, comm);
+    if (collect)
+        MPI_Gather(&u[halo], (int)n, MPI_DOUBLE, field, (int)n, MPI_DOUBLE, 0, comm);
+
+    free(u);
+    free(v);
+    return end_time - start_time;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size;
+    long cells = 1 << 20; // Cells per process (weak scaling) / total cells per process at full size (strong)
+    long steps = 200;     // Time steps per run
+    int halo = 1;         // Ghost width = steps between exchanges
+
+    // Initialize the MPI environment
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task4_stencil [cells_per_process] [steps] [halo_width]
+    if (argc > 1)
+        cells = atol(argv[1]);
+    if (argc > 2)
+        steps = atol(argv[2]);
+    if (argc > 3)
+        halo = atoi(argv[3]);
+
+    if (halo < 1 || cells < 2 * halo || steps < 1)
+    {
+        if (rank == 0)
+            printf("Error: need halo >= 1, cells per process >= 2 * halo and steps >= 1.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    double heat, t_off, t_on;
+    double initial_heat = 0;
+    long global_n = cells * size;
+    for (long g = 0; g < global_n; g++)
+        initial_heat += initial_value(g, global_n);
+
+    // Overlap on vs off on all processes; both final fields are checked cell by
+    // cell against a serial run, which a wide halo must reproduce exactly
+    double *field_off = NULL, *field_on = NULL, *reference = NULL;
+    if (rank == 0)
+    {
+        field_off = (double *)malloc(global_n * sizeof(double));
+        field_on = (double *)malloc(global_n * sizeof(double));
+        reference = (double *)malloc(global_n * sizeof(double));
+    }
+    t_off = run_stencil(MPI_COMM_WORLD, cells, steps, halo, 0, &heat, 1, field_off);
+    t_on = run_stencil(MPI_COMM_WORLD, cells, steps, halo, 1, &heat, 1, field_on);
+    if (rank == 0)
+    {
+        serial_reference(global_n, steps, reference);
+        double max_diff = 0;
+        for (long g = 0; g < global_n; g++)
+        {
+            double d_off = fabs(field_off[g] - reference[g]), d_on = fabs(field_on[g] - reference[g]);
+            max_diff = d_off > max_diff ? d_off : max_diff;
+            max_diff = d_on > max_diff ? d_on : max_diff;
+        }
+
+        printf("Heat stencil: %ld cells per process, %ld steps, halo %d, %d processes\n", cells, steps, halo, size);
+        printf("Blocking exchange: %.1f iterations/s\n", steps / t_off);
+        printf("Overlapped exchange: %.1f iterations/s (%.2fx)\n", steps / t_on, t_off / t_on);
+        printf("Heat conserved: %.6f of %.0f\n", heat, initial_heat);
+        printf("Max difference from the serial run: %g\n", max_diff);
+        printf("\n%6s %14s %12s %14s %12s\n", "procs", "strong it/s", "strong eff", "weak it/s", "weak eff");
+    }
+
+    // Strong and weak scaling on the first p processes, p = 1, 2, 4, ..., size
+    double strong_base = 0, weak_base = 0;
+    for (int p = 1; p <= size; p = (p * 2 > size && p != size) ? size : p * 2)
+    {
+        MPI_Comm sub;
+        MPI_Comm_split(MPI_COMM_WORLD, rank < p ? 0 : MPI_UNDEFINED, rank, &sub);
+
+        double t_strong = 0, t_weak = 0;
+        if (sub != MPI_COMM_NULL)
+        {
+            // Strong: the full-size global domain split over p processes
+            long strong_cells = cells * size / p;
+            t_strong = run_stencil(sub, strong_cells, steps, halo, 1, &heat, 0, NULL);
+
+            // Weak: a fixed number of cells per process
+            t_weak = run_stencil(sub, cells, steps, halo, 1, &heat, 0, NULL);
+            MPI_Comm_free(&sub);
+        }
+
+        if (rank == 0)
+        {
+            if (p == 1)
+            {
+                strong_base = t_strong;
+                weak_base = t_weak;
+            }
+            printf("%6d %14.1f %11.0f%% %14.1f %11.0f%%\n", p,
+                   steps / t_strong, 100.0 * strong_base / (p * t_strong),
+                   steps / t_weak, 100.0 * weak_base / t_weak);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    // Clean up
+    free(field_off);
+    free(field_on);
+    free(reference);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
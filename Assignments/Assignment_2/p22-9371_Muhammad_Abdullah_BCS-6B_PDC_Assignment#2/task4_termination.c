@@ -0,0 +1,339 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For realloc and atoi
+#include <mpi.h>    // For MPI functions
+
+#define TAG_WORK 1        // Basic message: one work item
+#define TAG_TOKEN 2       // Termination-detection token
+#define TAG_DONE 0        // Termination announcement, forwarded around the ring as in task4.c
+#define WHITE 0           // Process/token colours of the Dijkstra-Safra algorithm
+#define BLACK 1
+#define MAX_CHILDREN 3    // A work item spawns 0 .. MAX_CHILDREN new items
+#define PENDING_SENDS 256 // Work items in flight from one process
+
+// A unit of work: its seed decides how many children it spawns and where they go
+typedef struct
+{
+    long long seed;
+    long long depth;
+} Item;
+
+// Growable stack of local work
+typedef struct
+{
+    Item *items;
+    long count, capacity;
+} Queue;
+
+// Dijkstra-Safra state of this process. `counter` is basic messages sent
+// minus received; a process turns black when it receives one. The token sums
+// the counters around the ring and turns black if it passes a black process:
+// a white token returning with a zero total to a white, passive process 0
+// proves that nobody is active and no message is still in flight.
+typedef struct
+{
+    long long counter;
+    int color;
+    int has_token;
+    long long token[2]; // Accumulated counter, colour
+} Safra;
+
+static unsigned long long mix(unsigned long long x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Number of children of an item; deeper items have none
+static int children(const Item *item, int max_depth)
+{
+    if (item->depth >= max_depth)
+        return 0;
+    return (int)(mix(item->seed) % (MAX_CHILDREN + 1));
+}
+
+static Item child(const Item *item, int c)
+{
+    Item next = {(long long)mix(item->seed + c + 1), item->depth + 1};
+    return next;
+}
+
+static void push(Queue *q, Item item)
+{
+    if (q->count == q->capacity)
+    {
+        q->capacity = q->capacity ? q->capacity * 2 : 1024;
+        q->items = (Item *)realloc(q->items, q->capacity * sizeof(Item));
+    }
+    q->items[q->count++] = item;
+}
+
+// Stand-in for real work on an item
+static double compute(const Item *item, int work)
+{
+    double x = (double)(item->seed & 1023);
+    for (int i = 0; i < work; i++)
+        x = x * 0.999 + 1.0;
+    return x;
+}
+
+// Index of an idle send slot, or -1 if every send is still in flight
+static int free_slot(MPI_Request *requests)
+{
+    for (int i = 0; i < PENDING_SENDS; i++)
+        if (requests[i] == MPI_REQUEST_NULL)
+            return i;
+    int slot, flag;
+    MPI_Testany(PENDING_SENDS, requests, &slot, &flag, MPI_STATUS_IGNORE);
+    return flag ? slot : -1;
+}
+
+// Receive one pending message (work, token or done); returns 1 on TAG_DONE
+static int handle_message(MPI_Status *status, Queue *q, Safra *s, long long *token_hops)
+{
+    if (status->MPI_TAG == TAG_WORK)
+    {
+        Item item;
+        MPI_Recv(&item, 2, MPI_LONG_LONG, status->MPI_SOURCE, TAG_WORK, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        push(q, item);
+        s->counter--;
+        s->color = BLACK;
+        return 0;
+    }
+    if (status->MPI_TAG == TAG_TOKEN)
+    {
+        MPI_Recv(s->token, 2, MPI_LONG_LONG, status->MPI_SOURCE, TAG_TOKEN, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        s->has_token = 1;
+        (*token_hops)++;
+        return 0;
+    }
+    int dummy;
+    MPI_Recv(&dummy, 1, MPI_INT, status->MPI_SOURCE, TAG_DONE, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    return 1;
+}
+
+// Items the whole computation will process, expanded serially for checking
+static long long expected_items(long long roots, int max_depth)
+{
+    Queue q = {NULL, 0, 0};
+    long long total = 0;
+    for (long long r = 0; r < roots; r++)
+    {
+        Item root = {r, 0};
+        push(&q, root);
+        while (q.count > 0)
+        {
+            Item item = q.items[--q.count];
+            total++;
+            for (int c = 0; c < children(&item, max_depth); c++)
+                push(&q, child(&item, c));
+        }
+    }
+    free(q.items);
+    return total;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size;
+    long long roots = 2000; // Initial items, all placed on process 0
+    int max_depth = 10;     // Depth at which items stop spawning
+    int work = 2000;        // Compute iterations per item
+
+    // Initialize the MPI environment
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task4_termination [roots] [max_depth] [work_per_item]
+    if (argc > 1)
+        roots = atoll(argv[1]);
+    if (argc > 2)
+        max_depth = atoi(argv[2]);
+    if (argc > 3)
+        work = atoi(argv[3]);
+
+    if (size < 2 || roots <= 0 || max_depth < 0 || work < 0)
+    {
+        if (rank == 0)
+            printf("Error: need 2+ processes and non-negative work parameters.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    int next = (rank + 1) % size; // Token travels 0 -> 1 -> ... -> size-1 -> 0
+
+    // Clock offset of every process against process 0, from one ping-pong each
+    double offset = 0;
+    for (int r = 1; r < size; r++)
+    {
+        double t[3];
+        if (rank == 0)
+        {
+            t[0] = MPI_Wtime();
+            MPI_Send(t, 1, MPI_DOUBLE, r, TAG_DONE, MPI_COMM_WORLD);
+            MPI_Recv(&t[1], 1, MPI_DOUBLE, r, TAG_DONE, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            t[2] = MPI_Wtime();
+            double remote_offset = t[1] - (t[0] + t[2]) / 2;
+            MPI_Send(&remote_offset, 1, MPI_DOUBLE, r, TAG_DONE, MPI_COMM_WORLD);
+        }
+        else if (rank == r)
+        {
+            MPI_Recv(t, 1, MPI_DOUBLE, 0, TAG_DONE, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            t[1] = MPI_Wtime();
+            MPI_Send(&t[1], 1, MPI_DOUBLE, 0, TAG_DONE, MPI_COMM_WORLD);
+            MPI_Recv(&offset, 1, MPI_DOUBLE, 0, TAG_DONE, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        }
+    }
+
+    Queue q = {NULL, 0, 0};
+    if (rank == 0)
+        for (long long r = 0; r < roots; r++)
+        {
+            Item root = {r, 0};
+            push(&q, root);
+        }
+
+    Safra s = {0, WHITE, rank == 0, {0, WHITE}};
+    int probe_out = 0; // Process 0: a token is travelling
+    long long processed = 0, work_messages = 0, token_hops = 0, probes = 0;
+    double checksum = 0, last_passive = 0, detected = 0;
+
+    Item send_items[PENDING_SENDS];
+    MPI_Request send_requests[PENDING_SENDS];
+    for (int i = 0; i < PENDING_SENDS; i++)
+        send_requests[i] = MPI_REQUEST_NULL;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start_time = MPI_Wtime();
+
+    int done = 0;
+    while (!done)
+    {
+        MPI_Status status;
+        int flag;
+
+        // Active: process one item and send its children to their owners
+        if (q.count > 0)
+        {
+            Item item = q.items[--q.count];
+            checksum += compute(&item, work);
+            processed++;
+            for (int c = 0; c < children(&item, max_depth); c++)
+            {
+                Item spawned = child(&item, c);
+                int owner = (int)(mix(spawned.seed ^ 0x5555) % size);
+                if (owner == rank)
+                {
+                    push(&q, spawned);
+                    continue;
+                }
+
+                // Free send slot, draining our own receives while waiting
+                int slot;
+                while ((slot = free_slot(send_requests)) < 0)
+                {
+                    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &status);
+                    if (flag)
+                        done |= handle_message(&status, &q, &s, &token_hops);
+                }
+                send_items[slot] = spawned;
+                MPI_Isend(&send_items[slot], 2, MPI_LONG_LONG, owner, TAG_WORK, MPI_COMM_WORLD, &send_requests[slot]);
+                s.counter++;
+                work_messages++;
+            }
+
+            // Pick up whatever has arrived without blocking
+            MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &status);
+            while (flag)
+            {
+                done |= handle_message(&status, &q, &s, &token_hops);
+                MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &status);
+            }
+            if (q.count == 0)
+                last_passive = MPI_Wtime();
+            continue;
+        }
+
+        // Passive: start a probe, or pass the token on
+        if (rank == 0 && !probe_out)
+        {
+            s.token[0] = 0;
+            s.token[1] = WHITE;
+            s.color = WHITE;
+            s.has_token = 0;
+            probe_out = 1;
+            probes++;
+            MPI_Send(s.token, 2, MPI_LONG_LONG, next, TAG_TOKEN, MPI_COMM_WORLD);
+        }
+        else if (rank == 0 && s.has_token)
+        {
+            // The token has been around the ring
+            s.has_token = 0;
+            probe_out = 0;
+            if (s.token[1] == WHITE && s.color == WHITE && s.token[0] + s.counter == 0)
+            {
+                detected = MPI_Wtime();
+                int dummy = 0;
+                MPI_Send(&dummy, 1, MPI_INT, next, TAG_DONE, MPI_COMM_WORLD);
+                break;
+            }
+            continue; // Start another probe
+        }
+        else if (rank != 0 && s.has_token)
+        {
+            s.token[0] += s.counter;
+            if (s.color == BLACK)
+                s.token[1] = BLACK;
+            s.color = WHITE;
+            s.has_token = 0;
+            MPI_Send(s.token, 2, MPI_LONG_LONG, next, TAG_TOKEN, MPI_COMM_WORLD);
+        }
+
+        // Nothing to do until a message arrives
+        MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        if (handle_message(&status, &q, &s, &token_hops))
+        {
+            // Forward the announcement; the last process does not send it back to 0
+            int dummy = 0;
+            if (next != 0)
+                MPI_Send(&dummy, 1, MPI_INT, next, TAG_DONE, MPI_COMM_WORLD);
+            done = 1;
+        }
+    }
+
+    // Termination implies every work message was received, so these complete
+    MPI_Waitall(PENDING_SENDS, send_requests, MPI_STATUSES_IGNORE);
+    MPI_Barrier(MPI_COMM_WORLD);
+    double elapsed = MPI_Wtime() - start_time;
+
+    // Quiescence began when the last process went passive for good
+    double quiet = (last_passive > 0 ? last_passive : start_time) - offset, global_quiet, global_checksum;
+    long long totals[4] = {processed, work_messages, token_hops, s.counter}, global[4];
+    MPI_Reduce(&quiet, &global_quiet, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(totals, global, 4, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&checksum, &global_checksum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        long long expected = expected_items(roots, max_depth);
+        printf("Dynamic workload: %lld roots, depth %d, %d processes\n", roots, max_depth, size);
+        printf("Items processed = %lld (expected %lld), unbalanced message count = %lld\n",
+               global[0], expected, global[3]);
+        printf("Work messages = %lld, token messages = %lld over %lld probes (%.3f%% overhead)\n",
+               global[1], global[2], probes, 100.0 * global[2] / (global[1] > 0 ? global[1] : 1));
+        printf("Detection latency = %.1f us after global quiescence, total time = %f seconds\n",
+               (detected - global_quiet) * 1e6, elapsed);
+        printf("Checksum = %.6e\n", global_checksum);
+    }
+
+    // Clean up
+    free(q.items);
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,300 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atol
+#include <string.h> // For memset and strerror
+#include <errno.h>  // For the reason counters are unavailable
+#include <mpi.h>    // For MPI functions
+#ifdef __linux__
+#include <linux/perf_event.h> // For perf_event_attr
+#include <sys/ioctl.h>        // For enabling and disabling counters
+#include <sys/syscall.h>      // For the perf_event_open system call
+#include <unistd.h>           // For read and close
+#endif
+
+#define DEFAULT_ARRAY_SIZE (1 << 24) // Total number of elements in the array
+#define NUM_COUNTERS 5               // Hardware/software events counted per process
+#define NUM_PHASES 3                 // distribute, compute, collect
+#define NUM_METRICS (NUM_COUNTERS + 1)
+#define CACHE_LINE 64                // Bytes moved from memory per last-level miss
+
+static const char *phase_names[NUM_PHASES] = {"distribute", "compute", "collect"};
+
+// Counting (not sampling) file descriptors, one per event; -1 when the kernel,
+// the hardware or a container refused that event
+typedef struct
+{
+    int fd[NUM_COUNTERS];
+    int available; // Number of events that opened
+    int error;     // errno of the first failure, for the report
+} Counters;
+
+// Counter values at the start of the current phase, and totals per phase.
+// Metric 0 is wall time; metrics 1.. are the events, -1 when not counted.
+typedef struct
+{
+    double start[NUM_METRICS];
+    double total[NUM_PHASES][NUM_METRICS];
+} Phases;
+
+enum
+{
+    TASK_CLOCK,
+    CYCLES,
+    INSTRUCTIONS,
+    LLC_REFERENCES,
+    LLC_MISSES
+};
+
+static void counters_open(Counters *c)
+{
+    c->available = 0;
+    c->error = 0;
+#ifdef __linux__
+    const unsigned types[NUM_COUNTERS] = {PERF_TYPE_SOFTWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                          PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE};
+    const unsigned long long configs[NUM_COUNTERS] = {PERF_COUNT_SW_TASK_CLOCK, PERF_COUNT_HW_CPU_CYCLES,
+                                                      PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_REFERENCES,
+                                                      PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = 0; i < NUM_COUNTERS; i++)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = types[i];
+        attr.config = configs[i];
+        attr.exclude_kernel = 1; // Allowed at the default perf_event_paranoid level
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        c->fd[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (c->fd[i] < 0)
+        {
+            if (c->error == 0)
+                c->error = errno;
+            continue;
+        }
+        ioctl(c->fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(c->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+        c->available++;
+    }
+#else
+    for (int i = 0; i < NUM_COUNTERS; i++)
+        c->fd[i] = -1;
+    c->error = ENOSYS;
+#endif
+}
+
+static void counters_close(Counters *c)
+{
+#ifdef __linux__
+    for (int i = 0; i < NUM_COUNTERS; i++)
+        if (c->fd[i] >= 0)
+            close(c->fd[i]);
+#endif
+    (void)c;
+}
+
+// Current wall time and event counts; counts are scaled up when the kernel
+// had to multiplex more events than the PMU has registers
+static void counters_read(const Counters *c, double *values)
+{
+    values[0] = MPI_Wtime();
+    for (int i = 0; i < NUM_COUNTERS; i++)
+    {
+        values[i + 1] = -1;
+#ifdef __linux__
+        unsigned long long data[3]; // value, time enabled, time running
+        if (c->fd[i] >= 0 && read(c->fd[i], data, sizeof(data)) == (ssize_t)sizeof(data))
+            values[i + 1] = data[2] > 0 ? (double)data[0] * data[1] / data[2] : 0;
+#endif
+    }
+}
+
+static void phase_begin(const Counters *c, Phases *p)
+{
+    counters_read(c, p->start);
+}
+
+static void phase_end(const Counters *c, Phases *p, int phase)
+{
+    double now[NUM_METRICS];
+    counters_read(c, now);
+    for (int m = 0; m < NUM_METRICS; m++)
+        p->total[phase][m] = (now[m] < 0) ? -1 : p->total[phase][m] + now[m] - p->start[m];
+}
+
+// Pass p of the compute kernel on one element: square first, then a cheap mix.
+// Unsigned, so the multiplies wrap instead of overflowing.
+static unsigned kernel_step(unsigned value, int p)
+{
+    return (p == 0) ? value * value : (value ^ (value >> 7)) * 31u + (unsigned)p;
+}
+
+// One table row: derived metrics, or n/a where an event was not counted
+static void print_row(const char *phase, const char *who, const double *m)
+{
+    double wall = m[0];
+    printf("%-10s %-6s %10.3f", phase, who, wall * 1e3);
+    if (m[1 + TASK_CLOCK] >= 0 && wall > 0)
+        printf(" %7.0f%%", 100.0 * m[1 + TASK_CLOCK] * 1e-9 / wall);
+    else
+        printf(" %8s", "n/a");
+    if (m[1 + CYCLES] >= 0 && m[1 + INSTRUCTIONS] >= 0)
+        printf(" %10.1f %10.1f %6.2f", m[1 + CYCLES] / 1e6, m[1 + INSTRUCTIONS] / 1e6,
+               m[1 + CYCLES] > 0 ? m[1 + INSTRUCTIONS] / m[1 + CYCLES] : 0);
+    else
+        printf(" %10s %10s %6s", "n/a", "n/a", "n/a");
+    if (m[1 + LLC_MISSES] >= 0 && m[1 + LLC_REFERENCES] >= 0)
+        printf(" %10.1f %7.1f%% %10.1f", m[1 + LLC_MISSES] / 1e3,
+               m[1 + LLC_REFERENCES] > 0 ? 100.0 * m[1 + LLC_MISSES] / m[1 + LLC_REFERENCES] : 0,
+               wall > 0 ? m[1 + LLC_MISSES] * CACHE_LINE / wall / 1e6 : 0);
+    else
+        printf(" %10s %8s %10s", "n/a", "n/a", "n/a");
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size;
+    long array_size = DEFAULT_ARRAY_SIZE; // Total elements in the main array
+    int passes = 1;                       // Kernel passes per element; raise to make compute CPU-bound
+
+    // Initialize the MPI environment
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task5_counters [array_size] [compute_passes]
+    if (argc > 1)
+        array_size = atol(argv[1]);
+    if (argc > 2)
+        passes = atoi(argv[2]);
+
+    if (size < 2 || array_size < size - 1 || passes < 1)
+    {
+        if (rank == 0)
+            printf("Error: need 2+ processes, one element per worker and at least one pass.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    long segment_size = array_size / (size - 1); // Base segment size for each worker
+    long remainder = array_size % (size - 1);    // Extra elements to distribute evenly
+    unsigned *array = NULL, *result = NULL;
+    unsigned *segment = (unsigned *)malloc((segment_size + 1) * sizeof(unsigned));
+    if (rank == 0)
+    {
+        array = (unsigned *)malloc(array_size * sizeof(unsigned));
+        result = (unsigned *)malloc(array_size * sizeof(unsigned));
+        for (long i = 0; i < array_size; i++)
+            array[i] = (unsigned)(i % 30000) + 1;
+    }
+
+    Counters counters;
+    Phases phases;
+    memset(&phases, 0, sizeof(phases));
+    counters_open(&counters);
+
+    // Same blocking farm as task5_block.c, with each side's work split into phases
+    MPI_Barrier(MPI_COMM_WORLD);
+    int count = 0;
+    phase_begin(&counters, &phases);
+    if (rank == 0)
+    {
+        long offset = 0;
+        for (int i = 1; i < size; i++)
+        {
+            int send_size = (int)(segment_size + (i <= remainder ? 1 : 0));
+            MPI_Send(&send_size, 1, MPI_INT, i, 0, MPI_COMM_WORLD);
+            MPI_Send(&array[offset], send_size, MPI_UNSIGNED, i, 0, MPI_COMM_WORLD);
+            offset += send_size;
+        }
+    }
+    else
+    {
+        MPI_Recv(&count, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        MPI_Recv(segment, count, MPI_UNSIGNED, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
+    phase_end(&counters, &phases, 0);
+
+    phase_begin(&counters, &phases);
+    for (int p = 0; p < passes; p++)
+        for (int i = 0; i < count; i++)
+            segment[i] = kernel_step(segment[i], p);
+    phase_end(&counters, &phases, 1);
+
+    phase_begin(&counters, &phases);
+    if (rank == 0)
+    {
+        long offset = 0;
+        for (int i = 1; i < size; i++)
+        {
+            int recv_size = (int)(segment_size + (i <= remainder ? 1 : 0));
+            MPI_Recv(&result[offset], recv_size, MPI_UNSIGNED, i, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            offset += recv_size;
+        }
+    }
+    else
+    {
+        MPI_Send(segment, count, MPI_UNSIGNED, 0, 0, MPI_COMM_WORLD);
+    }
+    phase_end(&counters, &phases, 2);
+
+    // Every process's table goes to process 0
+    double *all = NULL;
+    if (rank == 0)
+        all = (double *)malloc((long)size * NUM_PHASES * NUM_METRICS * sizeof(double));
+    MPI_Gather(phases.total, NUM_PHASES * NUM_METRICS, MPI_DOUBLE, all, NUM_PHASES * NUM_METRICS, MPI_DOUBLE, 0,
+               MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        printf("Farm of %ld elements, %d processes, %d compute pass(es)\n", array_size, size, passes);
+        if (counters.available < NUM_COUNTERS)
+            printf("Note: %d of %d events available on process 0 (%s); missing ones show n/a\n",
+                   counters.available, NUM_COUNTERS, counters.error ? strerror(counters.error) : "unknown");
+        printf("%-10s %-6s %10s %8s %10s %10s %6s %10s %8s %10s\n", "phase", "rank", "wall (ms)", "on-cpu",
+               "cycles(M)", "instr(M)", "IPC", "LLC miss(K)", "miss rate", "DRAM MB/s");
+
+        for (int phase = 0; phase < NUM_PHASES; phase++)
+        {
+            // Aggregate: slowest wall time, summed events (n/a if any process lacked one)
+            double aggregate[NUM_METRICS] = {0};
+            for (int r = 0; r < size; r++)
+            {
+                const double *m = &all[((long)r * NUM_PHASES + phase) * NUM_METRICS];
+                char who[16];
+                snprintf(who, sizeof(who), "%d", r);
+                print_row(phase_names[phase], who, m);
+
+                aggregate[0] = m[0] > aggregate[0] ? m[0] : aggregate[0];
+                for (int k = 1; k < NUM_METRICS; k++)
+                    aggregate[k] = (m[k] < 0 || aggregate[k] < 0) ? -1 : aggregate[k] + m[k];
+            }
+            // On-CPU share of the aggregate is relative to all processes' wall time
+            if (aggregate[1 + TASK_CLOCK] >= 0)
+                aggregate[1 + TASK_CLOCK] /= size;
+            print_row(phase_names[phase], "all", aggregate);
+        }
+
+        long errors = 0;
+        for (long i = 0; i < array_size; i++)
+        {
+            unsigned expected = array[i];
+            for (int p = 0; p < passes; p++)
+                expected = kernel_step(expected, p);
+            if (result[i] != expected)
+                errors++;
+        }
+        printf("Errors = %ld\n", errors);
+    }
+
+    // Clean up
+    counters_close(&counters);
+    free(segment);
+    free(array);
+    free(result);
+    free(all);
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+    return 0;
+}
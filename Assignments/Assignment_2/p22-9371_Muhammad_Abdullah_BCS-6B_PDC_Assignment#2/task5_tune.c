@@ -0,0 +1,466 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atol
+#include <string.h> // For strcmp and memset
+#include <math.h>   // For fabs and log
+#include <mpi.h>    // For MPI functions
+
+#define TUNING_FILE "tuning.txt" // Default tuning profile written by "tune" and read by "run"
+#define MIN_TUNE_SIZE (1L << 10) // Smallest array size in the sweep
+#define MAX_TUNE_SIZE (1L << 22) // Largest array size in the sweep
+#define TUNE_REPS 3              // Repetitions per candidate (best one is kept)
+#define MAX_PROFILE_LINES 1024   // Entries kept from an existing profile
+
+enum
+{
+    STRATEGY_BLOCKING,    // MPI_Send/MPI_Recv per chunk (task5_block.c)
+    STRATEGY_NONBLOCKING, // MPI_Isend/MPI_Irecv per chunk (task5_nonBlock.c)
+    STRATEGY_COLLECTIVE,  // MPI_Scatterv/MPI_Gatherv (Assignment_3 task2.c)
+    STRATEGY_ONESIDED,    // Workers MPI_Get their segment and MPI_Put the result
+    NUM_STRATEGIES
+};
+
+static const char *strategy_names[] = {"blocking", "nonblocking", "collective", "onesided"};
+
+// Chunk sizes tried for the point-to-point strategies (0 = whole segment)
+static const long chunk_sizes[] = {0, 4096, 65536};
+#define NUM_CHUNKS (sizeof(chunk_sizes) / sizeof(chunk_sizes[0]))
+
+// Segment of worker i (1 .. size-1): the master keeps no data, as in task5_*.c
+static void worker_segment(long n, int size, int i, long *count, long *offset)
+{
+    long base = n / (size - 1), remainder = n % (size - 1);
+    *count = base + (i <= remainder ? 1 : 0);
+    *offset = (i - 1) * base + (i - 1 < remainder ? i - 1 : remainder);
+}
+
+static void square(int *values, long n)
+{
+    for (long i = 0; i < n; i++)
+        values[i] = values[i] * values[i];
+}
+
+static int num_chunks(long count, long chunk)
+{
+    if (chunk == 0 || count == 0)
+        return 1;
+    return (int)((count + chunk - 1) / chunk);
+}
+
+static long chunk_length(long count, long chunk, int c)
+{
+    if (chunk == 0)
+        return count;
+    long start = c * chunk;
+    return (count - start < chunk) ? count - start : chunk;
+}
+
+// ---------- Strategies: distribute, square on the workers, collect ----------
+
+static void run_blocking(int rank, int size, long n, long chunk, int *array, int *result, int *segment)
+{
+    long count, offset;
+    if (rank == 0)
+    {
+        for (int i = 1; i < size; i++)
+        {
+            worker_segment(n, size, i, &count, &offset);
+            for (int c = 0; c < num_chunks(count, chunk); c++)
+                MPI_Send(&array[offset + c * chunk], (int)chunk_length(count, chunk, c), MPI_INT, i, 0, MPI_COMM_WORLD);
+        }
+        for (int i = 1; i < size; i++)
+        {
+            worker_segment(n, size, i, &count, &offset);
+            for (int c = 0; c < num_chunks(count, chunk); c++)
+                MPI_Recv(&result[offset + c * chunk], (int)chunk_length(count, chunk, c), MPI_INT, i, 0,
+                         MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        }
+    }
+    else
+    {
+        worker_segment(n, size, rank, &count, &offset);
+        for (int c = 0; c < num_chunks(count, chunk); c++)
+            MPI_Recv(&segment[c * chunk], (int)chunk_length(count, chunk, c), MPI_INT, 0, 0,
+                     MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        square(segment, count);
+        for (int c = 0; c < num_chunks(count, chunk); c++)
+            MPI_Send(&segment[c * chunk], (int)chunk_length(count, chunk, c), MPI_INT, 0, 0, MPI_COMM_WORLD);
+    }
+}
+
+static void run_nonblocking(int rank, int size, long n, long chunk, int *array, int *result, int *segment)
+{
+    long count, offset;
+    if (rank == 0)
+    {
+        int total = 0;
+        for (int i = 1; i < size; i++)
+        {
+            worker_segment(n, size, i, &count, &offset);
+            total += num_chunks(count, chunk);
+        }
+        MPI_Request *requests = (MPI_Request *)malloc((total > 0 ? total : 1) * sizeof(MPI_Request));
+
+        int req_index = 0;
+        for (int i = 1; i < size; i++)
+        {
+            worker_segment(n, size, i, &count, &offset);
+            for (int c = 0; c < num_chunks(count, chunk); c++)
+                MPI_Isend(&array[offset + c * chunk], (int)chunk_length(count, chunk, c), MPI_INT, i, 0,
+                          MPI_COMM_WORLD, &requests[req_index++]);
+        }
+        MPI_Waitall(req_index, requests, MPI_STATUSES_IGNORE);
+
+        req_index = 0;
+        for (int i = 1; i < size; i++)
+        {
+            worker_segment(n, size, i, &count, &offset);
+            for (int c = 0; c < num_chunks(count, chunk); c++)
+                MPI_Irecv(&result[offset + c * chunk], (int)chunk_length(count, chunk, c), MPI_INT, i, 0,
+                          MPI_COMM_WORLD, &requests[req_index++]);
+        }
+        MPI_Waitall(req_index, requests, MPI_STATUSES_IGNORE);
+        free(requests);
+    }
+    else
+    {
+        worker_segment(n, size, rank, &count, &offset);
+        int chunks = num_chunks(count, chunk);
+        MPI_Request *requests = (MPI_Request *)malloc((chunks > 0 ? chunks : 1) * sizeof(MPI_Request));
+
+        for (int c = 0; c < chunks; c++)
+            MPI_Irecv(&segment[c * chunk], (int)chunk_length(count, chunk, c), MPI_INT, 0, 0,
+                      MPI_COMM_WORLD, &requests[c]);
+        MPI_Waitall(chunks, requests, MPI_STATUSES_IGNORE);
+
+        square(segment, count);
+
+        for (int c = 0; c < chunks; c++)
+            MPI_Isend(&segment[c * chunk], (int)chunk_length(count, chunk, c), MPI_INT, 0, 0,
+                      MPI_COMM_WORLD, &requests[c]);
+        MPI_Waitall(chunks, requests, MPI_STATUSES_IGNORE);
+        free(requests);
+    }
+}
+
+static void run_collective(int rank, int size, long n, int *array, int *result, int *segment)
+{
+    int counts[size], displs[size];
+    long count, offset;
+
+    // The root takes part in the collective with an empty share
+    counts[0] = 0;
+    displs[0] = 0;
+    for (int i = 1; i < size; i++)
+    {
+        worker_segment(n, size, i, &count, &offset);
+        counts[i] = (int)count;
+        displs[i] = (int)offset;
+    }
+
+    MPI_Scatterv(array, counts, displs, MPI_INT, segment, counts[rank], MPI_INT, 0, MPI_COMM_WORLD);
+    square(segment, counts[rank]);
+    MPI_Gatherv(segment, counts[rank], MPI_INT, result, counts, displs, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+static void run_onesided(int rank, int size, long n, MPI_Win array_win, MPI_Win result_win, int *segment)
+{
+    long count = 0, offset = 0;
+    if (rank != 0)
+        worker_segment(n, size, rank, &count, &offset);
+
+    // Workers pull their segment from the master's exposed array
+    MPI_Win_fence(0, array_win);
+    if (rank != 0)
+        MPI_Get(segment, (int)count, MPI_INT, 0, offset, (int)count, MPI_INT, array_win);
+    MPI_Win_fence(0, array_win);
+
+    square(segment, count);
+
+    // ...and push the squares straight into the master's result array
+    MPI_Win_fence(0, result_win);
+    if (rank != 0)
+        MPI_Put(segment, (int)count, MPI_INT, 0, offset, (int)count, MPI_INT, result_win);
+    MPI_Win_fence(0, result_win);
+}
+
+// Time one strategy (barrier to barrier, as task5_*.c) and verify its own result;
+// rank 0 gets -1 instead of a time if the result is wrong
+static double time_strategy(int strategy, long chunk, int rank, int size, long n,
+                            int *array, int *result, int *segment, MPI_Win array_win, MPI_Win result_win)
+{
+    double start_time, end_time;
+
+    // No square is 0, so any element this run fails to write is caught below
+    // instead of passing on a previous strategy's output
+    if (rank == 0)
+        memset(result, 0, n * sizeof(int));
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+
+    switch (strategy)
+    {
+    case STRATEGY_BLOCKING:
+        run_blocking(rank, size, n, chunk, array, result, segment);
+        break;
+    case STRATEGY_NONBLOCKING:
+        run_nonblocking(rank, size, n, chunk, array, result, segment);
+        break;
+    case STRATEGY_COLLECTIVE:
+        run_collective(rank, size, n, array, result, segment);
+        break;
+    case STRATEGY_ONESIDED:
+        run_onesided(rank, size, n, array_win, result_win, segment);
+        break;
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    end_time = MPI_Wtime();
+
+    if (rank == 0)
+        for (long i = 0; i < n; i++)
+            if (result[i] != array[i] * array[i])
+            {
+                printf("Error: %s (chunk %ld) produced a wrong result at %ld\n", strategy_names[strategy], chunk, i);
+                return -1;
+            }
+    return end_time - start_time;
+}
+
+// Buffers for one array size; the master exposes its arrays as RMA windows
+typedef struct
+{
+    int *array, *result, *segment;
+    MPI_Win array_win, result_win;
+} Buffers;
+
+static void buffers_create(Buffers *b, int rank, int size, long n)
+{
+    long count, offset;
+    worker_segment(n, size, 1, &count, &offset); // Worker 1 has the largest segment
+    b->segment = (int *)malloc(count * sizeof(int));
+    b->array = b->result = NULL;
+    if (rank == 0)
+    {
+        b->array = (int *)malloc(n * sizeof(int));
+        b->result = (int *)malloc(n * sizeof(int));
+        for (long i = 0; i < n; i++)
+            b->array[i] = (int)(i % 30000) + 1;
+    }
+    MPI_Aint bytes = (rank == 0) ? n * sizeof(int) : 0;
+    MPI_Win_create(b->array, bytes, sizeof(int), MPI_INFO_NULL, MPI_COMM_WORLD, &b->array_win);
+    MPI_Win_create(b->result, bytes, sizeof(int), MPI_INFO_NULL, MPI_COMM_WORLD, &b->result_win);
+}
+
+static void buffers_free(Buffers *b)
+{
+    MPI_Win_free(&b->array_win);
+    MPI_Win_free(&b->result_win);
+    free(b->array);
+    free(b->result);
+    free(b->segment);
+}
+
+// Lines of an existing profile that this sweep does not replace: entries for
+// other process counts, or for sizes outside the sweep. Returns the count.
+static int keep_other_entries(const char *path, int size, char lines[][256], int max_lines)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return 0;
+
+    char line[256], name[64];
+    int nprocs, kept = 0;
+    long elements, entry_chunk;
+    double seconds;
+    while (kept < max_lines && fgets(line, sizeof(line), file) != NULL)
+    {
+        if (line[0] == '#' || sscanf(line, "%d %ld %63s %ld %lf", &nprocs, &elements, name, &entry_chunk, &seconds) != 5)
+            continue;
+        int swept = 0;
+        for (long n = MIN_TUNE_SIZE; n <= MAX_TUNE_SIZE; n *= 4)
+            swept |= elements == n;
+        if (nprocs != size || !swept)
+            snprintf(lines[kept++], 256, "%s", line);
+    }
+    fclose(file);
+    return kept;
+}
+
+// Sweep sizes, strategies and chunk sizes; rank 0 then rewrites the profile
+// with the best entry per size for this process count, so re-tuning replaces
+// old (size, nprocs) entries instead of piling up duplicates
+static void tune(int rank, int size, const char *path)
+{
+    char results[16][256]; // One line per swept size (1K .. 4M in steps of 4)
+    int num_results = 0;
+
+    for (long n = MIN_TUNE_SIZE; n <= MAX_TUNE_SIZE; n *= 4)
+    {
+        Buffers b;
+        buffers_create(&b, rank, size, n);
+
+        int best_strategy = STRATEGY_BLOCKING;
+        long best_chunk = 0;
+        double best_time = -1; // None yet
+        for (int s = 0; s < NUM_STRATEGIES; s++)
+        {
+            // Only the point-to-point strategies are chunked
+            int chunks = (s == STRATEGY_BLOCKING || s == STRATEGY_NONBLOCKING) ? (int)NUM_CHUNKS : 1;
+            for (int c = 0; c < chunks; c++)
+            {
+                if (chunk_sizes[c] != 0 && chunk_sizes[c] >= n / (size - 1))
+                    continue; // Same as sending the whole segment
+
+                double t = 0;
+                int wrong = 0;
+                for (int r = 0; r < TUNE_REPS; r++)
+                {
+                    double elapsed = time_strategy(s, chunk_sizes[c], rank, size, n, b.array, b.result,
+                                                   b.segment, b.array_win, b.result_win);
+                    wrong |= elapsed < 0;
+                    if (r == 0 || elapsed < t)
+                        t = elapsed;
+                }
+                if (wrong)
+                    continue; // Never a candidate, however fast
+                if (rank == 0)
+                    printf("N = %8ld  %-12s chunk %6ld: %f seconds\n", n, strategy_names[s], chunk_sizes[c], t);
+                if (best_time < 0 || t < best_time)
+                {
+                    best_strategy = s;
+                    best_chunk = chunk_sizes[c];
+                    best_time = t;
+                }
+            }
+        }
+        if (best_time >= 0) // Otherwise every candidate was wrong; leave this size out
+            snprintf(results[num_results++], 256, "%d %ld %s %ld %.9f\n", size, n,
+                     strategy_names[best_strategy], best_chunk, best_time);
+
+        buffers_free(&b);
+    }
+
+    if (rank != 0)
+        return;
+
+    char (*kept)[256] = malloc(MAX_PROFILE_LINES * sizeof(*kept));
+    int num_kept = keep_other_entries(path, size, kept, MAX_PROFILE_LINES);
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        printf("Error: cannot write %s\n", path);
+        free(kept);
+        return;
+    }
+    fprintf(file, "# nprocs elements strategy chunk seconds\n");
+    for (int i = 0; i < num_kept; i++)
+        fputs(kept[i], file);
+    for (int i = 0; i < num_results; i++)
+        fputs(results[i], file);
+    fclose(file);
+    free(kept);
+    printf("Tuning profile for %d processes written to %s (%d other entries kept)\n", size, path, num_kept);
+}
+
+// Pick the entry for this process count whose size is closest (on a log scale)
+// to n; tune() keeps one entry per (nprocs, size), so ties are between sizes.
+// Falls back to non-blocking whole segments when nothing matches.
+static void lookup(const char *path, int size, long n, int *strategy, long *chunk)
+{
+    *strategy = STRATEGY_NONBLOCKING;
+    *chunk = 0;
+
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return;
+
+    char line[256], name[64];
+    int nprocs;
+    long elements, entry_chunk;
+    double seconds, best_distance = -1;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (line[0] == '#' || sscanf(line, "%d %ld %63s %ld %lf", &nprocs, &elements, name, &entry_chunk, &seconds) != 5)
+            continue;
+        if (nprocs != size)
+            continue;
+
+        for (int s = 0; s < NUM_STRATEGIES; s++)
+            if (strcmp(name, strategy_names[s]) == 0)
+            {
+                double distance = fabs(log((double)elements) - log((double)n));
+                if (best_distance < 0 || distance <= best_distance)
+                {
+                    best_distance = distance;
+                    *strategy = s;
+                    *chunk = entry_chunk;
+                }
+            }
+    }
+    fclose(file);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size;
+
+    // Initialize MPI environment
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task5_tune tune [profile]
+    //        task5_tune run <array_size> [profile]
+    // "run" is the tuned entry point for the farm. task5_block.c and
+    // task5_nonBlock.c stay fixed 16-element demos of one strategy each and
+    // do not read the profile.
+    int tuning = argc > 1 && strcmp(argv[1], "tune") == 0;
+    int running = argc > 2 && strcmp(argv[1], "run") == 0;
+    if (size < 2 || (!tuning && !running))
+    {
+        if (rank == 0)
+            printf("Usage: task5_tune tune [profile] | task5_tune run <array_size> [profile] (2+ processes)\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    if (tuning)
+    {
+        tune(rank, size, argc > 2 ? argv[2] : TUNING_FILE);
+    }
+    else
+    {
+        long n = atol(argv[2]);
+        const char *path = argc > 3 ? argv[3] : TUNING_FILE;
+        if (n < size - 1)
+        {
+            if (rank == 0)
+                printf("Error: need at least one element per worker.\n");
+            MPI_Finalize();
+            return 1;
+        }
+
+        // Rank 0 reads the profile and tells everyone which strategy to use
+        int choice[2] = {0, 0};
+        if (rank == 0)
+        {
+            long chunk;
+            lookup(path, size, n, &choice[0], &chunk);
+            choice[1] = (int)chunk;
+        }
+        MPI_Bcast(choice, 2, MPI_INT, 0, MPI_COMM_WORLD);
+
+        Buffers b;
+        buffers_create(&b, rank, size, n);
+        double t = time_strategy(choice[0], choice[1], rank, size, n, b.array, b.result,
+                                 b.segment, b.array_win, b.result_win);
+        if (rank == 0)
+            printf("Selected %s (chunk %d) for N = %ld: %f seconds\n", strategy_names[choice[0]], choice[1], n, t);
+        buffers_free(&b);
+    }
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+    return 0;
+}
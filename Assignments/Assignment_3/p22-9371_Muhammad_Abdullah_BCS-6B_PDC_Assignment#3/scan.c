@@ -0,0 +1,226 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc, atol and strcmp
+#include <string.h> // For strcmp
+#include <mpi.h>    // For MPI functions
+
+#define DEFAULT_LOCAL_SIZE (1 << 20) // Elements owned by each process
+#define BLOCK 8                      // Width of the in-register block scan
+
+// Value stored at a global index, so every process count sees the same input
+static long long input_value(long long global_index)
+{
+    return (global_index % 7) + 1;
+}
+
+// Inclusive scan of n elements into out, starting from carry.
+// Each block of 8 is scanned with log-step additions that do not depend on
+// the running carry, so the compiler can keep them in vector registers; the
+// carry is then added once per element and only the last lane feeds forward.
+static long long block_scan(const long long *in, long long *out, long n, long long carry)
+{
+    long i = 0;
+    for (; i + BLOCK <= n; i += BLOCK)
+    {
+        long long t[BLOCK];
+        for (int j = 0; j < BLOCK; j++)
+            t[j] = in[i + j];
+
+        // Hillis-Steele scan within the block
+        for (int k = 1; k < BLOCK; k <<= 1)
+            for (int j = BLOCK - 1; j >= k; j--)
+                t[j] += t[j - k];
+
+        for (int j = 0; j < BLOCK; j++)
+            out[i + j] = t[j] + carry;
+        carry = out[i + BLOCK - 1];
+    }
+
+    // Tail that does not fill a whole block
+    for (; i < n; i++)
+    {
+        carry += in[i];
+        out[i] = carry;
+    }
+    return carry;
+}
+
+// Sum of n elements (read-only pass, vectorizes as a plain reduction)
+static long long local_sum(const long long *in, long n)
+{
+    long long sum = 0;
+    for (long i = 0; i < n; i++)
+        sum += in[i];
+    return sum;
+}
+
+// Turn an inclusive scan into an exclusive one by subtracting each input
+static void make_exclusive(const long long *in, long long *out, long n)
+{
+    for (long i = 0; i < n; i++)
+        out[i] -= in[i];
+}
+
+// Three-phase scan: local scan, MPI_Exscan of the totals, add offsets locally
+static void scan_three_phase(const long long *in, long long *out, long n, int exclusive)
+{
+    long long total = block_scan(in, out, n, 0);
+    long long offset = 0;
+
+    // Offset of this process = sum of the totals of all lower ranks
+    MPI_Exscan(&total, &offset, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank == 0)
+        offset = 0; // MPI_Exscan leaves rank 0's result undefined
+
+    for (long i = 0; i < n; i++)
+        out[i] += offset;
+
+    if (exclusive)
+        make_exclusive(in, out, n);
+}
+
+// Fused scan: read-only sum, MPI_Exscan, then a single scan pass seeded with
+// the offset. For large segments this saves one read-modify-write sweep.
+static void scan_fused(const long long *in, long long *out, long n, int exclusive)
+{
+    long long total = local_sum(in, n);
+    long long offset = 0;
+
+    MPI_Exscan(&total, &offset, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank == 0)
+        offset = 0;
+
+    block_scan(in, out, n, offset);
+
+    if (exclusive)
+        make_exclusive(in, out, n);
+}
+
+// Baseline the current project structure would force: gather everything to
+// process 0, scan serially there and scatter the results back.
+static void scan_gather_root(const long long *in, long long *out, long n, int exclusive)
+{
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    long long *full = NULL;
+    if (rank == 0)
+        full = (long long *)malloc((size_t)n * size * sizeof(long long));
+
+    MPI_Gather(in, (int)n, MPI_LONG_LONG, full, (int)n, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        long long running = 0;
+        for (long i = 0; i < n * size; i++)
+        {
+            long long value = full[i];
+            running += value;
+            full[i] = exclusive ? running - value : running;
+        }
+    }
+
+    MPI_Scatter(full, (int)n, MPI_LONG_LONG, out, (int)n, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+
+    free(full);
+}
+
+// Time one scan variant (barrier-to-barrier, like task5_block.c)
+static double time_scan(void (*scan)(const long long *, long long *, long, int),
+                        const long long *in, long long *out, long n, int exclusive, int reps)
+{
+    double start_time, end_time;
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    for (int r = 0; r < reps; r++)
+        scan(in, out, n, exclusive);
+    MPI_Barrier(MPI_COMM_WORLD);
+    end_time = MPI_Wtime();
+    return (end_time - start_time) / reps;
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    long n = DEFAULT_LOCAL_SIZE; // Elements per process
+    int exclusive = 0;           // 0 = inclusive scan, 1 = exclusive scan
+    int fused = 0;               // Use the fused one-pass local scan
+    int reps = 5;                // Repetitions for timing
+
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: scan [elements_per_process] [inclusive|exclusive] [fused] [reps]
+    if (argc > 1)
+        n = atol(argv[1]);
+    if (argc > 2)
+        exclusive = strcmp(argv[2], "exclusive") == 0;
+    if (argc > 3)
+        fused = strcmp(argv[3], "fused") == 0;
+    if (argc > 4)
+        reps = atoi(argv[4]);
+
+    if (n <= 0 || reps <= 0)
+    {
+        if (rank == 0)
+            printf("Error: elements per process and repetitions must be positive.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    long long *in = (long long *)malloc(n * sizeof(long long));
+    long long *out = (long long *)malloc(n * sizeof(long long));
+    long long *reference = (long long *)malloc(n * sizeof(long long));
+
+    // Each process fills its own contiguous slice of the global array
+    for (long i = 0; i < n; i++)
+        in[i] = input_value((long long)rank * n + i);
+
+    void (*scan)(const long long *, long long *, long, int) = fused ? scan_fused : scan_three_phase;
+
+    double dist_time = time_scan(scan, in, out, n, exclusive, reps);
+    double root_time = time_scan(scan_gather_root, in, reference, n, exclusive, reps);
+
+    // Check the distributed result against the gather-to-root baseline
+    long mismatches = 0, total_mismatches = 0;
+    for (long i = 0; i < n; i++)
+        if (out[i] != reference[i])
+            mismatches++;
+    MPI_Reduce(&mismatches, &total_mismatches, 1, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    // The last process holds the grand total at the end of its slice
+    if (rank == size - 1)
+        printf("Process %d: last %s prefix = %lld\n", rank,
+               exclusive ? "exclusive" : "inclusive", out[n - 1]);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        double elements = (double)n * size;
+        printf("Scan of %ld elements on %d processes (%s, %s)\n", (long)elements, size,
+               exclusive ? "exclusive" : "inclusive", fused ? "fused" : "three-phase");
+        printf("Distributed scan time: %f seconds (%.1f M elements/s)\n",
+               dist_time, elements / dist_time / 1e6);
+        printf("Gather-to-root scan time: %f seconds (%.1f M elements/s)\n",
+               root_time, elements / root_time / 1e6);
+        printf("Speedup over gather-to-root: %.2fx\n", root_time / dist_time);
+        printf("Mismatches against baseline: %ld\n", total_mismatches);
+    }
+
+    // Clean up
+    free(in);
+    free(out);
+    free(reference);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,278 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atol
+#include <stdint.h> // For fixed-width integer types
+#include <string.h> // For strcmp and memset
+#include <mpi.h>    // For MPI functions
+
+#define DEFAULT_RECORDS (1L << 23) // Records generated per process
+#define DEFAULT_KEYS (1L << 20)    // Distinct keys in the whole data set
+#define BATCH (1L << 20)           // Records shuffled per MPI_Alltoallv round
+#define EMPTY_KEY UINT64_MAX       // Marks a free hash-table slot
+
+typedef struct
+{
+    uint64_t key;
+    int64_t value;
+} Record;
+
+// Open-addressing table with linear probing. Keys and values live in separate
+// arrays so a probe sequence walks one contiguous cache line of keys.
+typedef struct
+{
+    uint64_t *keys;
+    int64_t *values;
+    long capacity, count; // capacity is a power of two
+} HashTable;
+
+// 64-bit mixer (splitmix64 finalizer) used for both placement and routing
+static uint64_t mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static void table_init(HashTable *t, long capacity)
+{
+    t->capacity = capacity;
+    t->count = 0;
+    t->keys = (uint64_t *)malloc(capacity * sizeof(uint64_t));
+    t->values = (int64_t *)malloc(capacity * sizeof(int64_t));
+    memset(t->keys, 0xFF, capacity * sizeof(uint64_t)); // All slots EMPTY_KEY
+}
+
+static void table_free(HashTable *t)
+{
+    free(t->keys);
+    free(t->values);
+}
+
+static void table_add(HashTable *t, uint64_t key, int64_t value);
+
+// Double the capacity once the table is half full
+static void table_grow(HashTable *t)
+{
+    HashTable bigger;
+    table_init(&bigger, t->capacity * 2);
+    for (long i = 0; i < t->capacity; i++)
+        if (t->keys[i] != EMPTY_KEY)
+            table_add(&bigger, t->keys[i], t->values[i]);
+    table_free(t);
+    *t = bigger;
+}
+
+static void table_add(HashTable *t, uint64_t key, int64_t value)
+{
+    long mask = t->capacity - 1;
+    long slot = (long)(mix(key) >> 16) & mask; // High bits; the low bits chose the rank
+    while (t->keys[slot] != EMPTY_KEY && t->keys[slot] != key)
+        slot = (slot + 1) & mask;
+
+    if (t->keys[slot] == key)
+    {
+        t->values[slot] += value;
+        return;
+    }
+    t->keys[slot] = key;
+    t->values[slot] = value;
+    if (++t->count * 2 > t->capacity)
+        table_grow(t);
+}
+
+// Owner of a key
+static int destination(uint64_t key, int size)
+{
+    return (int)(mix(key) % (uint64_t)size);
+}
+
+// Word-count style input: skewed keys (small keys are more frequent), value 1
+static void generate(Record *records, long n, int rank, long distinct)
+{
+    for (long i = 0; i < n; i++)
+    {
+        uint64_t r = mix(((uint64_t)rank << 40) ^ (uint64_t)i);
+        double u = (r >> 11) * (1.0 / 9007199254740992.0);
+        records[i].key = (uint64_t)(u * u * distinct);
+        records[i].value = 1;
+    }
+}
+
+// Shuffle `n` records to their owners in batches and aggregate them into table.
+// Each batch is bucketed by destination with a counting sort, the counts are
+// exchanged with MPI_Alltoall and the records with one MPI_Alltoallv.
+static long long shuffle(const Record *records, long n, HashTable *table, MPI_Datatype record_type,
+                         int size, long long *bytes_sent)
+{
+    int send_counts[size], recv_counts[size], send_displs[size], recv_displs[size], fill[size];
+    Record *send_buf = (Record *)malloc(BATCH * sizeof(Record));
+    Record *recv_buf = NULL;
+    long recv_capacity = 0;
+    long long received = 0;
+
+    // Every process must take part in the same number of rounds
+    long local_rounds = (n + BATCH - 1) / BATCH, rounds;
+    MPI_Allreduce(&local_rounds, &rounds, 1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+
+    for (long round = 0; round < rounds; round++)
+    {
+        long start = round * BATCH;
+        long count = (start >= n) ? 0 : ((n - start < BATCH) ? n - start : BATCH);
+
+        // Counting sort into per-destination buckets
+        memset(send_counts, 0, sizeof(send_counts));
+        for (long i = 0; i < count; i++)
+            send_counts[destination(records[start + i].key, size)]++;
+        for (int d = 0, offset = 0; d < size; d++)
+        {
+            send_displs[d] = offset;
+            fill[d] = offset;
+            offset += send_counts[d];
+        }
+        for (long i = 0; i < count; i++)
+            send_buf[fill[destination(records[start + i].key, size)]++] = records[start + i];
+
+        MPI_Alltoall(send_counts, 1, MPI_INT, recv_counts, 1, MPI_INT, MPI_COMM_WORLD);
+        long total = 0;
+        for (int d = 0; d < size; d++)
+        {
+            recv_displs[d] = (int)total;
+            total += recv_counts[d];
+            *bytes_sent += (long long)send_counts[d] * sizeof(Record);
+        }
+        if (total > recv_capacity)
+        {
+            free(recv_buf);
+            recv_capacity = total;
+            recv_buf = (Record *)malloc(recv_capacity * sizeof(Record));
+        }
+
+        MPI_Alltoallv(send_buf, send_counts, send_displs, record_type,
+                      recv_buf, recv_counts, recv_displs, record_type, MPI_COMM_WORLD);
+
+        for (long i = 0; i < total; i++)
+            table_add(table, recv_buf[i].key, recv_buf[i].value);
+        received += total;
+    }
+
+    free(send_buf);
+    free(recv_buf);
+    return received;
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    long n = DEFAULT_RECORDS;     // Records per process
+    long distinct = DEFAULT_KEYS; // Distinct keys overall
+    int combine = 0;              // Pre-aggregate locally before shuffling
+
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: shuffle [records_per_process] [distinct_keys] [combine]
+    if (argc > 1)
+        n = atol(argv[1]);
+    if (argc > 2)
+        distinct = atol(argv[2]);
+    if (argc > 3)
+        combine = strcmp(argv[3], "combine") == 0;
+
+    if (n <= 0 || distinct <= 0)
+    {
+        if (rank == 0)
+            printf("Error: record and key counts must be positive.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    // One record = one MPI element (16 bytes)
+    MPI_Datatype record_type;
+    MPI_Type_contiguous(sizeof(Record), MPI_BYTE, &record_type);
+    MPI_Type_commit(&record_type);
+
+    Record *records = (Record *)malloc(n * sizeof(Record));
+    generate(records, n, rank, distinct);
+
+    HashTable table;
+    table_init(&table, 1 << 16);
+    long long bytes_sent = 0;
+    double start_time, end_time;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+
+    const Record *input = records;
+    long input_count = n;
+    HashTable local;
+    Record *combined = NULL;
+    if (combine)
+    {
+        // Combiner: sum duplicates locally so each key is shuffled at most once per process
+        table_init(&local, 1 << 16);
+        for (long i = 0; i < n; i++)
+            table_add(&local, records[i].key, records[i].value);
+        combined = (Record *)malloc(local.count * sizeof(Record));
+        input_count = 0;
+        for (long i = 0; i < local.capacity; i++)
+            if (local.keys[i] != EMPTY_KEY)
+            {
+                combined[input_count].key = local.keys[i];
+                combined[input_count].value = local.values[i];
+                input_count++;
+            }
+        table_free(&local);
+        input = combined;
+    }
+
+    long long received = shuffle(input, input_count, &table, record_type, size, &bytes_sent);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    end_time = MPI_Wtime();
+
+    // Every count must be accounted for, and every key must sit on its owner
+    long long local_sum = 0, global_sum, local_keys = table.count, global_keys;
+    long long local_misplaced = 0, global_misplaced;
+    for (long i = 0; i < table.capacity; i++)
+        if (table.keys[i] != EMPTY_KEY)
+        {
+            local_sum += table.values[i];
+            if (destination(table.keys[i], size) != rank)
+                local_misplaced++;
+        }
+    long long totals[3] = {local_sum, local_keys, local_misplaced}, global[3];
+    MPI_Reduce(totals, global, 3, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    global_sum = global[0];
+    global_keys = global[1];
+    global_misplaced = global[2];
+
+    long long total_bytes, max_received;
+    MPI_Reduce(&bytes_sent, &total_bytes, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&received, &max_received, 1, MPI_LONG_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        double elapsed = end_time - start_time;
+        printf("Shuffle + aggregate: %ld records per process, %d processes, %s\n",
+               n, size, combine ? "with combiner" : "no combiner");
+        printf("Time = %f seconds, %.2f M records/s per process, %.2f M records/s total\n",
+               elapsed, n / elapsed / 1e6, (double)n * size / elapsed / 1e6);
+        printf("Shuffled %.1f MB, largest receiver got %lld records\n", total_bytes / 1e6, max_received);
+        printf("Distinct keys = %lld, counted records = %lld of %lld, misplaced keys = %lld\n",
+               global_keys, global_sum, (long long)n * size, global_misplaced);
+    }
+
+    // Clean up
+    table_free(&table);
+    free(records);
+    free(combined);
+    MPI_Type_free(&record_type);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
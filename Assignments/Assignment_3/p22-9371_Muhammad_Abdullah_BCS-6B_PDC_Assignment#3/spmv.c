@@ -0,0 +1,435 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc, qsort, bsearch and strtol
+#include <string.h> // For strstr and memset
+#include <ctype.h>  // For tolower
+#include <math.h>   // For fabs
+#include <mpi.h>    // For MPI functions
+
+#define DEFAULT_GRID 1000 // Without a file: 2D Laplacian on a grid x grid mesh
+#define MAX_LINE 1024
+
+// Compressed sparse rows; column indices are local (see build_plan)
+typedef struct
+{
+    long rows;
+    long *row_ptr;
+    int *col;
+    double *val;
+} CSR;
+
+// One stored entry of this process's rows, before compression
+typedef struct
+{
+    long row; // Local row
+    long col; // Global column
+    double val;
+} Entry;
+
+typedef struct
+{
+    Entry *items;
+    long count, capacity;
+} Entries;
+
+// Who needs which of our x entries, and where the x entries we need come from.
+// Built once from the sparsity pattern; every multiply then moves only these.
+typedef struct
+{
+    int *send_counts, *send_displs, *recv_counts, *recv_displs;
+    int *send_index; // Local x positions to pack, grouped by destination
+    long ghosts;     // Remote x entries received per multiply
+    double *send_buf, *ghost;
+} Plan;
+
+static void add_entry(Entries *e, long row, long col, double val)
+{
+    if (e->count == e->capacity)
+    {
+        e->capacity = e->capacity ? e->capacity * 2 : 1024;
+        e->items = (Entry *)realloc(e->items, e->capacity * sizeof(Entry));
+    }
+    Entry entry = {row, col, val};
+    e->items[e->count++] = entry;
+}
+
+// First global row of process r; rows are split evenly
+static long first_row(long n, int size, int r)
+{
+    return n * r / size;
+}
+
+static int owner(long n, int size, long row)
+{
+    int lo = 0, hi = size - 1;
+    while (lo < hi)
+    {
+        int mid = (lo + hi + 1) / 2;
+        if (first_row(n, size, mid) <= row)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+// Rows [first, last) of a Matrix Market coordinate file. Every process reads
+// the file and keeps its own rows; symmetric and skew-symmetric files are
+// expanded. Returns -1 for an unsupported header, an entry outside the
+// matrix, or a file that ends before all nnz entries.
+static long load_matrix_market(const char *path, long *first, long *last, int rank, int size, Entries *e)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return -1;
+
+    char line[MAX_LINE];
+    if (fgets(line, sizeof(line), file) == NULL || strncmp(line, "%%MatrixMarket", 14) != 0)
+    {
+        fclose(file);
+        return -1;
+    }
+    for (char *p = line; *p; p++)
+        *p = (char)tolower((unsigned char)*p);
+    int skew = strstr(line, "skew-symmetric") != NULL;
+    int symmetric = strstr(line, "symmetric") != NULL; // Also true for skew-symmetric
+    int pattern = strstr(line, "pattern") != NULL;
+    if (strstr(line, "coordinate") == NULL || strstr(line, "complex") != NULL || strstr(line, "hermitian") != NULL)
+    {
+        fclose(file);
+        return -1;
+    }
+
+    long m = 0, n = 0, nnz = 0;
+    while (fgets(line, sizeof(line), file) != NULL)
+        if (line[0] != '%')
+        {
+            if (sscanf(line, "%ld %ld %ld", &m, &n, &nnz) != 3)
+                m = 0;
+            break;
+        }
+    if (m <= 0 || m != n || nnz < 0)
+    {
+        fclose(file);
+        return -1;
+    }
+
+    *first = first_row(n, size, rank);
+    *last = first_row(n, size, rank + 1);
+    long k = 0;
+    while (k < nnz && fgets(line, sizeof(line), file) != NULL)
+    {
+        long i, j;
+        double v = 1.0;
+        if (line[0] == '%')
+            continue;
+        if (sscanf(line, "%ld %ld %lf", &i, &j, &v) < (pattern ? 2 : 3) || i < 1 || i > n || j < 1 || j > n)
+            break; // Malformed or outside the matrix
+        if (pattern)
+            v = 1.0;
+        i--, j--; // Matrix Market is 1-based
+        if (i >= *first && i < *last)
+            add_entry(e, i - *first, j, v);
+        if (symmetric && i != j && j >= *first && j < *last)
+            add_entry(e, j - *first, i, skew ? -v : v);
+        k++;
+    }
+    fclose(file);
+    return k == nnz ? n : -1;
+}
+
+// 5-point Laplacian on a grid x grid mesh, generated row by row
+static long generate_laplacian(long grid, long *first, long *last, int rank, int size, Entries *e)
+{
+    long n = grid * grid;
+    *first = first_row(n, size, rank);
+    *last = first_row(n, size, rank + 1);
+    for (long i = *first; i < *last; i++)
+    {
+        long r = i / grid, c = i % grid;
+        add_entry(e, i - *first, i, 4.0);
+        if (r > 0)
+            add_entry(e, i - *first, i - grid, -1.0);
+        if (r < grid - 1)
+            add_entry(e, i - *first, i + grid, -1.0);
+        if (c > 0)
+            add_entry(e, i - *first, i - 1, -1.0);
+        if (c < grid - 1)
+            add_entry(e, i - *first, i + 1, -1.0);
+    }
+    return n;
+}
+
+static int compare_longs(const void *a, const void *b)
+{
+    long x = *(const long *)a, y = *(const long *)b;
+    return (x > y) - (x < y);
+}
+
+// Compress the entries whose columns are local (remote = 0) or ghost (remote = 1)
+// into CSR. Local columns become offsets from `first`; ghost columns become
+// positions in the sorted ghost list, i.e. indices into the received buffer.
+static void build_csr(CSR *a, const Entries *e, long rows, int remote, long first, long last,
+                      const long *ghost_cols, long ghosts)
+{
+    a->rows = rows;
+    a->row_ptr = (long *)calloc(rows + 1, sizeof(long));
+    for (long k = 0; k < e->count; k++)
+    {
+        int is_remote = e->items[k].col < first || e->items[k].col >= last;
+        if (is_remote == remote)
+            a->row_ptr[e->items[k].row + 1]++;
+    }
+    for (long i = 0; i < rows; i++)
+        a->row_ptr[i + 1] += a->row_ptr[i];
+
+    long nnz = a->row_ptr[rows];
+    a->col = (int *)malloc((nnz > 0 ? nnz : 1) * sizeof(int));
+    a->val = (double *)malloc((nnz > 0 ? nnz : 1) * sizeof(double));
+    long *fill = (long *)malloc((rows + 1) * sizeof(long));
+    for (long i = 0; i <= rows; i++)
+        fill[i] = a->row_ptr[i];
+    for (long k = 0; k < e->count; k++)
+    {
+        const Entry *t = &e->items[k];
+        int is_remote = t->col < first || t->col >= last;
+        if (is_remote != remote)
+            continue;
+        long column = remote ? (const long *)bsearch(&t->col, ghost_cols, ghosts, sizeof(long), compare_longs) -
+                                   ghost_cols
+                             : t->col - first;
+        a->col[fill[t->row]] = (int)column;
+        a->val[fill[t->row]++] = t->val;
+    }
+    free(fill);
+}
+
+static void free_csr(CSR *a)
+{
+    free(a->row_ptr);
+    free(a->col);
+    free(a->val);
+}
+
+// y (+)= A x. Four independent partial sums per row break the dependency
+// chain so the gathers and multiply-adds of consecutive entries can overlap
+// and vectorize.
+static void csr_multiply(const CSR *a, const double *restrict x, double *restrict y, int accumulate)
+{
+    for (long i = 0; i < a->rows; i++)
+    {
+        long k = a->row_ptr[i], end = a->row_ptr[i + 1];
+        double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (; k + 4 <= end; k += 4)
+        {
+            s0 += a->val[k] * x[a->col[k]];
+            s1 += a->val[k + 1] * x[a->col[k + 1]];
+            s2 += a->val[k + 2] * x[a->col[k + 2]];
+            s3 += a->val[k + 3] * x[a->col[k + 3]];
+        }
+        for (; k < end; k++)
+            s0 += a->val[k] * x[a->col[k]];
+        double sum = (s0 + s1) + (s2 + s3);
+        y[i] = accumulate ? y[i] + sum : sum;
+    }
+}
+
+// Analyze the pattern once: the sorted remote columns this process touches,
+// grouped by owner, and (via one MPI_Alltoall/Alltoallv) the reverse lists
+// of which local x entries every other process needs from us.
+static long *build_plan(Plan *p, const Entries *e, long n, long first, long last, int size)
+{
+    long *cols = (long *)malloc((e->count > 0 ? e->count : 1) * sizeof(long));
+    long count = 0;
+    for (long k = 0; k < e->count; k++)
+        if (e->items[k].col < first || e->items[k].col >= last)
+            cols[count++] = e->items[k].col;
+    qsort(cols, count, sizeof(long), compare_longs);
+    long ghosts = 0;
+    for (long k = 0; k < count; k++)
+        if (ghosts == 0 || cols[k] != cols[ghosts - 1])
+            cols[ghosts++] = cols[k];
+    p->ghosts = ghosts;
+
+    p->send_counts = (int *)calloc(size, sizeof(int));
+    p->recv_counts = (int *)calloc(size, sizeof(int));
+    p->send_displs = (int *)malloc(size * sizeof(int));
+    p->recv_displs = (int *)malloc(size * sizeof(int));
+    for (long k = 0; k < ghosts; k++)
+        p->recv_counts[owner(n, size, cols[k])]++;
+    MPI_Alltoall(p->recv_counts, 1, MPI_INT, p->send_counts, 1, MPI_INT, MPI_COMM_WORLD);
+
+    long total_send = 0;
+    for (int r = 0, recv_offset = 0; r < size; r++)
+    {
+        p->recv_displs[r] = recv_offset;
+        p->send_displs[r] = (int)total_send;
+        recv_offset += p->recv_counts[r];
+        total_send += p->send_counts[r];
+    }
+
+    // Tell every owner which of its entries we need (global indices)
+    long *wanted = (long *)malloc((total_send > 0 ? total_send : 1) * sizeof(long));
+    MPI_Alltoallv(cols, p->recv_counts, p->recv_displs, MPI_LONG, wanted, p->send_counts, p->send_displs,
+                  MPI_LONG, MPI_COMM_WORLD);
+    p->send_index = (int *)malloc((total_send > 0 ? total_send : 1) * sizeof(int));
+    for (long k = 0; k < total_send; k++)
+        p->send_index[k] = (int)(wanted[k] - first);
+    free(wanted);
+
+    p->send_buf = (double *)malloc((total_send > 0 ? total_send : 1) * sizeof(double));
+    p->ghost = (double *)malloc((ghosts > 0 ? ghosts : 1) * sizeof(double));
+    return cols; // Sorted ghost columns, for renumbering
+}
+
+static void free_plan(Plan *p)
+{
+    free(p->send_counts);
+    free(p->send_displs);
+    free(p->recv_counts);
+    free(p->recv_displs);
+    free(p->send_index);
+    free(p->send_buf);
+    free(p->ghost);
+}
+
+// y = A x with the exchange of ghost entries hidden behind the local block
+static void spmv(const CSR *local, const CSR *remote, Plan *p, const double *x, double *y, int size,
+                 MPI_Request *requests)
+{
+    int n_req = 0;
+    for (int r = 0; r < size; r++)
+        if (p->recv_counts[r] > 0)
+            MPI_Irecv(&p->ghost[p->recv_displs[r]], p->recv_counts[r], MPI_DOUBLE, r, 0, MPI_COMM_WORLD,
+                      &requests[n_req++]);
+    for (int r = 0; r < size; r++)
+        if (p->send_counts[r] > 0)
+        {
+            for (int k = p->send_displs[r]; k < p->send_displs[r] + p->send_counts[r]; k++)
+                p->send_buf[k] = x[p->send_index[k]];
+            MPI_Isend(&p->send_buf[p->send_displs[r]], p->send_counts[r], MPI_DOUBLE, r, 0, MPI_COMM_WORLD,
+                      &requests[n_req++]);
+        }
+
+    csr_multiply(local, x, y, 0);
+    MPI_Waitall(n_req, requests, MPI_STATUSES_IGNORE);
+    csr_multiply(remote, p->ghost, y, 1);
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    const char *source = NULL; // Matrix Market file, or a grid size
+    int iterations = 50;       // Multiplies per measurement
+
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: spmv [matrix.mtx | grid_size] [iterations]
+    if (argc > 1)
+        source = argv[1];
+    if (argc > 2)
+        iterations = atoi(argv[2]);
+
+    Entries entries = {NULL, 0, 0};
+    long n, first = 0, last = 0, grid = DEFAULT_GRID;
+    char *end = NULL;
+    if (source != NULL)
+        grid = strtol(source, &end, 10);
+    if (source == NULL || (*end == '\0' && grid > 0))
+        n = generate_laplacian(grid, &first, &last, rank, size, &entries);
+    else
+        n = load_matrix_market(source, &first, &last, rank, size, &entries);
+
+    long bad = (n < size || iterations <= 0), any_bad;
+    MPI_Allreduce(&bad, &any_bad, 1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+    if (any_bad)
+    {
+        if (rank == 0)
+            printf("Error: need a valid square coordinate Matrix Market file (or grid size) with a row per\n"
+                   "process, and a positive iteration count.\n");
+        free(entries.items);
+        MPI_Finalize();
+        return 1;
+    }
+    long rows = last - first;
+
+    // Communication plan and the matrix split into local and ghost columns
+    Plan plan;
+    long *ghost_cols = build_plan(&plan, &entries, n, first, last, size);
+    CSR local, remote;
+    build_csr(&local, &entries, rows, 0, first, last, ghost_cols, plan.ghosts);
+    build_csr(&remote, &entries, rows, 1, first, last, ghost_cols, plan.ghosts);
+
+    double *x = (double *)malloc(rows * sizeof(double));
+    double *y = (double *)malloc(rows * sizeof(double));
+    double *y_ref = (double *)malloc(rows * sizeof(double));
+    for (long i = 0; i < rows; i++)
+        x[i] = 1.0 + (double)((first + i) % 7) / 7.0;
+    MPI_Request *requests = (MPI_Request *)malloc(2 * size * sizeof(MPI_Request));
+
+    double start_time, planned_time, gather_time;
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    for (int it = 0; it < iterations; it++)
+        spmv(&local, &remote, &plan, x, y, size, requests);
+    MPI_Barrier(MPI_COMM_WORLD);
+    planned_time = (MPI_Wtime() - start_time) / iterations;
+
+    // Baseline and reference: gather the whole x everywhere, multiply with global columns
+    int counts[size], displs[size];
+    for (int r = 0; r < size; r++)
+    {
+        displs[r] = (int)first_row(n, size, r);
+        counts[r] = (int)(first_row(n, size, r + 1) - displs[r]);
+    }
+    double *x_full = (double *)malloc(n * sizeof(double));
+    CSR global;
+    build_csr(&global, &entries, rows, 0, 0, n, NULL, 0);
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    for (int it = 0; it < iterations; it++)
+    {
+        MPI_Allgatherv(x, (int)rows, MPI_DOUBLE, x_full, counts, displs, MPI_DOUBLE, MPI_COMM_WORLD);
+        csr_multiply(&global, x_full, y_ref, 0);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    gather_time = (MPI_Wtime() - start_time) / iterations;
+
+    double error = 0, max_error;
+    for (long i = 0; i < rows; i++)
+        error = fabs(y[i] - y_ref[i]) > error ? fabs(y[i] - y_ref[i]) : error;
+    long stats[2] = {local.row_ptr[rows] + remote.row_ptr[rows], plan.ghosts}, totals[2], max_ghosts;
+    MPI_Reduce(&error, &max_error, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(stats, totals, 2, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&plan.ghosts, &max_ghosts, 1, MPI_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        double flops = 2.0 * totals[0];
+        printf("SpMV: %ld x %ld, %ld nonzeros, %d processes, %d iterations\n", n, n, totals[0], size, iterations);
+        printf("Planned exchange:  %10.3f ms, %7.3f GFLOP/s, %.1f KB exchanged per iteration (max %ld ghosts on one process)\n",
+               planned_time * 1e3, flops / planned_time / 1e9, totals[1] * sizeof(double) / 1e3, max_ghosts);
+        printf("Allgatherv of x:   %10.3f ms, %7.3f GFLOP/s, %.1f KB exchanged per iteration\n", gather_time * 1e3,
+               flops / gather_time / 1e9, (double)(size - 1) * n * sizeof(double) / 1e3);
+        printf("Max difference between the two = %g\n", max_error);
+    }
+
+    // Clean up
+    free_csr(&local);
+    free_csr(&remote);
+    free_csr(&global);
+    free_plan(&plan);
+    free(ghost_cols);
+    free(entries.items);
+    free(x);
+    free(y);
+    free(y_ref);
+    free(x_full);
+    free(requests);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
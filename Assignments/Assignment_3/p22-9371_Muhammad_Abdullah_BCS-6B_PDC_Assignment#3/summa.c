@@ -0,0 +1,183 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atoi
+#include <string.h> // For memcpy and memset
+#include <math.h>   // For sqrt and fabs
+#include <mpi.h>    // For MPI functions
+
+#define TILE 64 // Cache block for the local kernel (3 tiles of doubles fit in L2)
+
+// Global entries of A and B, so every process can build and check its own blocks
+static double a_value(long i, long j)
+{
+    return (double)((i * 3 + j) % 11) / 11.0;
+}
+
+static double b_value(long i, long j)
+{
+    return (double)((i + 2 * j) % 13) / 13.0;
+}
+
+// C += A * B for nb x nb row-major blocks. Tiled i-k-j order: the innermost
+// loop streams a row of the B tile into a row of the C tile, which the
+// compiler vectorizes.
+static void local_gemm(int nb, const double *restrict a, const double *restrict b, double *restrict c)
+{
+    for (int ii = 0; ii < nb; ii += TILE)
+        for (int kk = 0; kk < nb; kk += TILE)
+            for (int jj = 0; jj < nb; jj += TILE)
+            {
+                int i_end = ii + TILE < nb ? ii + TILE : nb;
+                int k_end = kk + TILE < nb ? kk + TILE : nb;
+                int j_end = jj + TILE < nb ? jj + TILE : nb;
+                for (int i = ii; i < i_end; i++)
+                    for (int k = kk; k < k_end; k++)
+                    {
+                        double aik = a[(long)i * nb + k];
+                        for (int j = jj; j < j_end; j++)
+                            c[(long)i * nb + j] += aik * b[(long)k * nb + j];
+                    }
+            }
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    int n = 1024; // Global matrix dimension
+
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: summa [matrix_size]
+    if (argc > 1)
+        n = atoi(argv[1]);
+
+    // SUMMA here uses a square q x q process grid with equal blocks
+    int q = (int)(sqrt((double)size) + 0.5);
+    if (q * q != size || n <= 0 || n % q != 0)
+    {
+        if (rank == 0 && q * q != size)
+            printf("Error: SUMMA needs a square number of processes (got %d).\n", size);
+        else if (rank == 0)
+            printf("Error: Matrix size %d must be positive and divisible by %d.\n", n, q);
+        MPI_Finalize();
+        return 1;
+    }
+    int nb = n / q; // Local block dimension
+
+    // 2D Cartesian grid, plus row and column communicators for the panel broadcasts
+    MPI_Comm grid, row_comm, col_comm;
+    int dims[2] = {q, q}, periods[2] = {0, 0}, coords[2];
+    int keep_cols[2] = {0, 1}, keep_rows[2] = {1, 0};
+    MPI_Cart_create(MPI_COMM_WORLD, 2, dims, periods, 0, &grid);
+    MPI_Cart_coords(grid, rank, 2, coords);
+    MPI_Cart_sub(grid, keep_cols, &row_comm); // Same grid row, rank = grid column
+    MPI_Cart_sub(grid, keep_rows, &col_comm); // Same grid column, rank = grid row
+    int my_row = coords[0], my_col = coords[1];
+
+    long block = (long)nb * nb;
+    double *a = (double *)malloc(block * sizeof(double));
+    double *b = (double *)malloc(block * sizeof(double));
+    double *c = (double *)calloc(block, sizeof(double));
+    double *a_panel[2], *b_panel[2];
+    for (int p = 0; p < 2; p++)
+    {
+        a_panel[p] = (double *)malloc(block * sizeof(double));
+        b_panel[p] = (double *)malloc(block * sizeof(double));
+    }
+
+    // Each process fills its own blocks of A and B
+    for (int i = 0; i < nb; i++)
+        for (int j = 0; j < nb; j++)
+        {
+            a[(long)i * nb + j] = a_value((long)my_row * nb + i, (long)my_col * nb + j);
+            b[(long)i * nb + j] = b_value((long)my_row * nb + i, (long)my_col * nb + j);
+        }
+
+    double start_time, end_time, gemm_time = 0;
+    MPI_Request requests[2];
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+
+    // Step k: grid column k broadcasts its A blocks along the rows and grid row k
+    // broadcasts its B blocks down the columns. The broadcasts for step k + 1 are
+    // posted before multiplying step k, so they overlap with the local GEMM.
+    if (my_col == 0)
+        memcpy(a_panel[0], a, block * sizeof(double));
+    if (my_row == 0)
+        memcpy(b_panel[0], b, block * sizeof(double));
+    MPI_Ibcast(a_panel[0], (int)block, MPI_DOUBLE, 0, row_comm, &requests[0]);
+    MPI_Ibcast(b_panel[0], (int)block, MPI_DOUBLE, 0, col_comm, &requests[1]);
+
+    for (int k = 0; k < q; k++)
+    {
+        int cur = k % 2, nxt = 1 - cur;
+        MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
+
+        if (k + 1 < q)
+        {
+            if (my_col == k + 1)
+                memcpy(a_panel[nxt], a, block * sizeof(double));
+            if (my_row == k + 1)
+                memcpy(b_panel[nxt], b, block * sizeof(double));
+            MPI_Ibcast(a_panel[nxt], (int)block, MPI_DOUBLE, k + 1, row_comm, &requests[0]);
+            MPI_Ibcast(b_panel[nxt], (int)block, MPI_DOUBLE, k + 1, col_comm, &requests[1]);
+        }
+
+        double t = MPI_Wtime();
+        local_gemm(nb, a_panel[cur], b_panel[cur], c);
+        gemm_time += MPI_Wtime() - t;
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    end_time = MPI_Wtime();
+
+    // Check a sample of this process's entries against a direct dot product
+    double max_error = 0, global_error;
+    for (int s = 0; s < 16; s++)
+    {
+        int i = (s * 37) % nb, j = (s * 53) % nb;
+        long gi = (long)my_row * nb + i, gj = (long)my_col * nb + j;
+        double expected = 0;
+        for (long k = 0; k < n; k++)
+            expected += a_value(gi, k) * b_value(k, gj);
+        double error = fabs(expected - c[(long)i * nb + j]);
+        if (error > max_error)
+            max_error = error;
+    }
+    MPI_Reduce(&max_error, &global_error, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    double local_flops = 2.0 * nb * nb * (double)n; // This process's share of 2 n^3
+    double rank_gflops = local_flops / gemm_time / 1e9;
+    double min_gflops, max_gflops;
+    MPI_Reduce(&rank_gflops, &min_gflops, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&rank_gflops, &max_gflops, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        double elapsed = end_time - start_time;
+        printf("SUMMA: %d x %d matrices on a %d x %d grid (blocks of %d)\n", n, n, q, q, nb);
+        printf("Time = %f seconds, aggregate = %.2f GFLOP/s\n", elapsed, 2.0 * n * n * (double)n / elapsed / 1e9);
+        printf("Local kernel per process: %.2f .. %.2f GFLOP/s\n", min_gflops, max_gflops);
+        printf("Max sampled error = %.3e\n", global_error);
+    }
+
+    // Clean up
+    for (int p = 0; p < 2; p++)
+    {
+        free(a_panel[p]);
+        free(b_panel[p]);
+    }
+    free(a);
+    free(b);
+    free(c);
+    MPI_Comm_free(&row_comm);
+    MPI_Comm_free(&col_comm);
+    MPI_Comm_free(&grid);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,215 @@
+#include <stdio.h>    // For input/output functions
+#include <stdlib.h>   // For malloc, free and atol
+#include <sys/mman.h> // For madvise (transparent hugepages)
+#include <mpi.h>      // For MPI functions
+
+#define MIN_CLASS_SHIFT 12       // Smallest size class: 4 KB
+#define NUM_CLASSES 20           // Classes 4 KB .. 2 GB, powers of two
+#define MAX_FREE_PER_CLASS 16    // Cached buffers kept per class
+#define HUGEPAGE_BYTES (2 << 20) // Classes at least this big are advised to use hugepages
+
+// One free list per power-of-two size class
+typedef struct
+{
+    void *blocks[MAX_FREE_PER_CLASS];
+    int count;
+} FreeList;
+
+// Size-class pool on top of MPI_Alloc_mem, so buffers stay registered with the
+// network between iterations instead of being re-allocated every time
+typedef struct
+{
+    FreeList classes[NUM_CLASSES];
+    long hits, misses;      // Requests served from a free list / by a new allocation
+    size_t held, peak_held; // Bytes owned by the pool (in use + cached), and its maximum
+} BufferPool;
+
+// Smallest class that holds `bytes`, or -1 if it is bigger than the largest class
+static int size_class(size_t bytes)
+{
+    for (int c = 0; c < NUM_CLASSES; c++)
+        if (((size_t)1 << (c + MIN_CLASS_SHIFT)) >= bytes)
+            return c;
+    return -1;
+}
+
+static void *pool_get(BufferPool *pool, size_t bytes)
+{
+    int c = size_class(bytes);
+    FreeList *list = c >= 0 ? &pool->classes[c] : NULL;
+    if (list != NULL && list->count > 0)
+    {
+        pool->hits++;
+        return list->blocks[--list->count];
+    }
+
+    // Miss: allocate a whole class-sized buffer through MPI (or exactly `bytes`
+    // for a request beyond the largest class; pool_put frees those directly)
+    size_t class_bytes = c >= 0 ? (size_t)1 << (c + MIN_CLASS_SHIFT) : bytes;
+    void *buffer;
+    MPI_Alloc_mem((MPI_Aint)class_bytes, MPI_INFO_NULL, &buffer);
+#ifdef MADV_HUGEPAGE
+    if (class_bytes >= HUGEPAGE_BYTES)
+        madvise(buffer, class_bytes, MADV_HUGEPAGE); // Only a hint; ignored if unaligned/unsupported
+#endif
+
+    pool->misses++;
+    pool->held += class_bytes;
+    if (pool->held > pool->peak_held)
+        pool->peak_held = pool->held;
+    return buffer;
+}
+
+static void pool_put(BufferPool *pool, void *buffer, size_t bytes)
+{
+    if (buffer == NULL)
+        return;
+
+    int c = size_class(bytes);
+    if (c >= 0 && pool->classes[c].count < MAX_FREE_PER_CLASS)
+    {
+        pool->classes[c].blocks[pool->classes[c].count++] = buffer;
+        return;
+    }
+
+    // Oversized, or free list full: give the memory back
+    MPI_Free_mem(buffer);
+    pool->held -= c >= 0 ? (size_t)1 << (c + MIN_CLASS_SHIFT) : bytes;
+}
+
+static void pool_destroy(BufferPool *pool)
+{
+    for (int c = 0; c < NUM_CLASSES; c++)
+        for (int i = 0; i < pool->classes[c].count; i++)
+            MPI_Free_mem(pool->classes[c].blocks[i]);
+}
+
+// Element count used in a given iteration: cycles through 1x .. 4x the base size
+static long iteration_size(long base, int iter)
+{
+    return base * (1 + iter % 4);
+}
+
+// One task2_b.c iteration: scatter, multiply by 2, gather (divisible portion only).
+// Buffers come from the pool when one is given, otherwise from malloc/free.
+// Returns the time spent allocating and freeing.
+static double run_iteration(int rank, int size, long n, BufferPool *pool)
+{
+    long chunk_size = n / size;
+    size_t chunk_bytes = chunk_size * sizeof(int);
+    size_t full_bytes = n * sizeof(int);
+    int *full_array = NULL, *final_array = NULL, *local_chunk;
+    double alloc_time = 0, t;
+
+    t = MPI_Wtime();
+    local_chunk = pool ? (int *)pool_get(pool, chunk_bytes) : (int *)malloc(chunk_bytes);
+    if (rank == 0)
+    {
+        full_array = pool ? (int *)pool_get(pool, full_bytes) : (int *)malloc(full_bytes);
+        final_array = pool ? (int *)pool_get(pool, full_bytes) : (int *)malloc(full_bytes);
+    }
+    alloc_time += MPI_Wtime() - t;
+
+    if (rank == 0)
+        for (long i = 0; i < n; i++)
+            full_array[i] = (int)(i % 1000) + 1;
+
+    MPI_Scatter(full_array, (int)chunk_size, MPI_INT, local_chunk, (int)chunk_size, MPI_INT, 0, MPI_COMM_WORLD);
+    for (long i = 0; i < chunk_size; i++)
+        local_chunk[i] *= 2;
+    MPI_Gather(local_chunk, (int)chunk_size, MPI_INT, final_array, (int)chunk_size, MPI_INT, 0, MPI_COMM_WORLD);
+
+    if (rank == 0 && final_array[chunk_size * size - 1] != 2 * full_array[chunk_size * size - 1])
+        printf("Process 0: wrong result for N = %ld\n", n);
+
+    t = MPI_Wtime();
+    if (pool)
+    {
+        pool_put(pool, local_chunk, chunk_bytes);
+        pool_put(pool, full_array, full_bytes);
+        pool_put(pool, final_array, full_bytes);
+    }
+    else
+    {
+        free(local_chunk);
+        free(full_array);
+        free(final_array);
+    }
+    alloc_time += MPI_Wtime() - t;
+    return alloc_time;
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    long base = 1 << 20; // Smallest array size in the iteration cycle
+    int iterations = 40; // Iterations of the loop benchmark
+
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task2_b_pool [base_size] [iterations]
+    if (argc > 1)
+        base = atol(argv[1]);
+    if (argc > 2)
+        iterations = atoi(argv[2]);
+
+    if (iterations <= 0)
+    {
+        if (rank == 0)
+            printf("Error: iterations must be positive.\n");
+        MPI_Finalize();
+        return 1;
+    }
+    if (base / size == 0)
+    {
+        if (rank == 0)
+            printf("Error: Too many processes (%d) for array size %ld.\n", size, base);
+        MPI_Finalize();
+        return 1;
+    }
+
+    BufferPool pool = {0};
+    double start_time, end_time;
+    double alloc_time[2] = {0, 0}, loop_time[2];
+
+    // Pass 0: malloc/free every iteration (task2_b.c); pass 1: pooled buffers
+    for (int pass = 0; pass < 2; pass++)
+    {
+        MPI_Barrier(MPI_COMM_WORLD);
+        start_time = MPI_Wtime();
+        for (int iter = 0; iter < iterations; iter++)
+            alloc_time[pass] += run_iteration(rank, size, iteration_size(base, iter), pass ? &pool : NULL);
+        MPI_Barrier(MPI_COMM_WORLD);
+        end_time = MPI_Wtime();
+        loop_time[pass] = end_time - start_time;
+    }
+
+    // Report the slowest rank's allocation time and the pool statistics
+    double max_alloc[2];
+    long counts[2] = {pool.hits, pool.misses}, total_counts[2];
+    unsigned long long peak = pool.peak_held, max_peak;
+    MPI_Reduce(alloc_time, max_alloc, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(counts, total_counts, 2, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&peak, &max_peak, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        printf("Loop benchmark: %d iterations, N = %ld .. %ld, %d processes\n",
+               iterations, base, iteration_size(base, 3), size);
+        printf("malloc/free: loop = %f seconds, allocation = %f seconds\n", loop_time[0], max_alloc[0]);
+        printf("Buffer pool: loop = %f seconds, allocation = %f seconds\n", loop_time[1], max_alloc[1]);
+        printf("Pool hit rate = %.1f%% (%ld hits, %ld misses), peak footprint = %.1f MB on the largest rank\n",
+               100.0 * total_counts[0] / (total_counts[0] + total_counts[1]),
+               total_counts[0], total_counts[1], max_peak / 1e6);
+    }
+
+    // Clean up
+    pool_destroy(&pool);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
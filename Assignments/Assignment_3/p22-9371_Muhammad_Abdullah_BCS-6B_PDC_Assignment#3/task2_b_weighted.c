@@ -0,0 +1,262 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atol
+#include <time.h>   // For the age of the weights file
+#include <mpi.h>    // For MPI functions
+
+#define WEIGHTS_FILE "weights.txt" // Persisted calibration, one weight per rank
+#define MAX_WEIGHT_AGE 3600        // Seconds before a saved calibration is redone
+#define KERNEL_PASSES 20           // Work per element of the kernel
+#define CALIBRATION_SIZE 65536     // Elements used to calibrate
+#define REFRESH_EVERY 10           // Iterations between in-run recalibrations
+
+// Per-element kernel; `slowdown` repeats it to emulate a slower node
+static void kernel(int *values, long n, int slowdown)
+{
+    for (int s = 0; s < slowdown; s++)
+        for (long i = 0; i < n; i++)
+        {
+            int y = values[i];
+            for (int p = 0; p < KERNEL_PASSES; p++)
+                y = (y * 7 + 3) % 1000003;
+            values[i] = (s == slowdown - 1) ? y : values[i];
+        }
+}
+
+// Cost of one element on this rank: kernel time plus the time to move it to
+// and from the root (zero on the root itself). Weights are 1 / cost.
+static double calibrate(int rank, int slowdown)
+{
+    int *sample = (int *)malloc(CALIBRATION_SIZE * sizeof(int));
+    for (long i = 0; i < CALIBRATION_SIZE; i++)
+        sample[i] = (int)i;
+
+    double start_time = MPI_Wtime();
+    kernel(sample, CALIBRATION_SIZE, slowdown);
+    double compute = (MPI_Wtime() - start_time) / CALIBRATION_SIZE;
+
+    // Ping-pong with the root, one rank at a time so the links are measured alone
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    double transfer = 0;
+    for (int r = 1; r < size; r++)
+    {
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (rank == r)
+        {
+            start_time = MPI_Wtime();
+            MPI_Send(sample, CALIBRATION_SIZE, MPI_INT, 0, 0, MPI_COMM_WORLD);
+            MPI_Recv(sample, CALIBRATION_SIZE, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            transfer = (MPI_Wtime() - start_time) / CALIBRATION_SIZE;
+        }
+        else if (rank == 0)
+        {
+            MPI_Recv(sample, CALIBRATION_SIZE, MPI_INT, r, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            MPI_Send(sample, CALIBRATION_SIZE, MPI_INT, r, 0, MPI_COMM_WORLD);
+        }
+    }
+
+    free(sample);
+    return 1.0 / (compute + transfer);
+}
+
+// Load saved weights if they exist, are recent, and were measured with the same
+// process count, emulate factor and kernel (passes and calibration size)
+static int load_weights(const char *path, int size, int emulate, double *weights)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return 0;
+
+    long saved_time;
+    int saved_size, saved_emulate, saved_passes, saved_calibration, ok = 0;
+    if (fscanf(file, "%ld %d %d %d %d", &saved_time, &saved_size, &saved_emulate, &saved_passes,
+               &saved_calibration) == 5 &&
+        saved_size == size && saved_emulate == emulate && saved_passes == KERNEL_PASSES &&
+        saved_calibration == CALIBRATION_SIZE && time(NULL) - saved_time < MAX_WEIGHT_AGE)
+    {
+        ok = 1;
+        for (int r = 0; r < size && ok; r++)
+            ok = fscanf(file, "%lf", &weights[r]) == 1 && weights[r] > 0;
+    }
+    fclose(file);
+    return ok;
+}
+
+static void save_weights(const char *path, int size, int emulate, const double *weights)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+        return;
+    fprintf(file, "%ld %d %d %d %d\n", (long)time(NULL), size, emulate, KERNEL_PASSES, CALIBRATION_SIZE);
+    for (int r = 0; r < size; r++)
+        fprintf(file, "%.6g\n", weights[r]);
+    fclose(file);
+}
+
+// Split n elements proportionally to the weights (largest remainders get the leftovers)
+static void weighted_counts(long n, int size, const double *weights, int *counts, int *displs)
+{
+    double total = 0;
+    for (int r = 0; r < size; r++)
+        total += weights[r];
+
+    long assigned = 0;
+    double remainder[size]; // Fraction of an element each rank was rounded down by
+    for (int r = 0; r < size; r++)
+    {
+        double share = n * weights[r] / total;
+        counts[r] = (int)share;
+        remainder[r] = share - counts[r];
+        assigned += counts[r];
+    }
+
+    // Fewer than `size` elements are left; each goes to the largest remaining fraction
+    for (; assigned < n; assigned++)
+    {
+        int best = 0;
+        for (int r = 1; r < size; r++)
+            if (remainder[r] > remainder[best])
+                best = r;
+        counts[best]++;
+        remainder[best] = -1;
+    }
+
+    for (int r = 0, offset = 0; r < size; r++)
+    {
+        displs[r] = offset;
+        offset += counts[r];
+    }
+}
+
+// One Scatterv / kernel / Gatherv iteration; returns the makespan
+static double run_iteration(int rank, int *full, int *result, int *local,
+                            const int *counts, const int *displs, int slowdown)
+{
+    double start_time, end_time;
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+
+    MPI_Scatterv(full, counts, displs, MPI_INT, local, counts[rank], MPI_INT, 0, MPI_COMM_WORLD);
+    kernel(local, counts[rank], slowdown);
+    MPI_Gatherv(local, counts[rank], MPI_INT, result, counts, displs, MPI_INT, 0, MPI_COMM_WORLD);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    end_time = MPI_Wtime();
+    return end_time - start_time;
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    long n = 1 << 20;    // Array size
+    int iterations = 30; // Iterations per partitioning
+    int emulate = 0;     // Emulate mixed hardware: rank r runs the kernel (r % emulate + 1) times
+
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task2_b_weighted [array_size] [iterations] [emulate_factor]
+    if (argc > 1)
+        n = atol(argv[1]);
+    if (argc > 2)
+        iterations = atoi(argv[2]);
+    if (argc > 3)
+        emulate = atoi(argv[3]);
+
+    if (n < size || iterations <= 0)
+    {
+        if (rank == 0)
+            printf("Error: need one element per process (%d) and a positive iteration count.\n", size);
+        MPI_Finalize();
+        return 1;
+    }
+    int slowdown = emulate > 0 ? rank % emulate + 1 : 1;
+
+    int *full = NULL, *result = NULL;
+    int *local = (int *)malloc(n * sizeof(int)); // A fast rank may get most of the array
+    if (rank == 0)
+    {
+        full = (int *)malloc(n * sizeof(int));
+        result = (int *)malloc(n * sizeof(int));
+        for (long i = 0; i < n; i++)
+            full[i] = (int)(i % 1000) + 1;
+    }
+
+    int counts[size], displs[size];
+    double weights[size];
+
+    // ---------- Equal partitioning (task2_b.c) ----------
+    for (int r = 0; r < size; r++)
+        weights[r] = 1.0;
+    weighted_counts(n, size, weights, counts, displs);
+    double equal_time = 0;
+    for (int it = 0; it < iterations; it++)
+        equal_time += run_iteration(rank, full, result, local, counts, displs, slowdown);
+
+    // ---------- Weighted partitioning ----------
+    int loaded = 0;
+    if (rank == 0)
+        loaded = load_weights(WEIGHTS_FILE, size, emulate, weights);
+    MPI_Bcast(&loaded, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    double calibration_time = 0, start_time;
+    double weighted_time = 0;
+    int calibrations = 0; // In this run; the final weights are saved ones only if 0
+    for (int it = 0; it < iterations; it++)
+    {
+        // Calibrate when nothing usable was saved, and refresh periodically
+        if ((it == 0 && !loaded) || (it > 0 && it % REFRESH_EVERY == 0))
+        {
+            start_time = MPI_Wtime();
+            double my_weight = calibrate(rank, slowdown);
+            MPI_Gather(&my_weight, 1, MPI_DOUBLE, weights, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+            if (rank == 0)
+                save_weights(WEIGHTS_FILE, size, emulate, weights);
+            calibration_time += MPI_Wtime() - start_time;
+            calibrations++;
+        }
+        MPI_Bcast(weights, size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        weighted_counts(n, size, weights, counts, displs);
+
+        weighted_time += run_iteration(rank, full, result, local, counts, displs, slowdown);
+    }
+
+    if (rank == 0)
+    {
+        long errors = 0;
+        for (long i = 0; i < n; i++)
+        {
+            int y = full[i];
+            for (int p = 0; p < KERNEL_PASSES; p++)
+                y = (y * 7 + 3) % 1000003;
+            if (result[i] != y)
+                errors++;
+        }
+
+        printf("Array of %ld elements, %d processes, %d iterations%s\n", n, size, iterations,
+               emulate > 0 ? " (emulated heterogeneous ranks)" : "");
+        if (calibrations == 0)
+            printf("Segments from saved (" WEIGHTS_FILE ") weights:");
+        else
+            printf("Segments from weights calibrated in this run (%d time(s)%s):", calibrations,
+                   loaded ? ", after starting from " WEIGHTS_FILE : "");
+        for (int r = 0; r < size; r++)
+            printf(" %d", counts[r]);
+        printf("\n");
+        printf("Equal partitioning:    makespan = %f seconds per iteration\n", equal_time / iterations);
+        printf("Weighted partitioning: makespan = %f seconds per iteration (%.2fx)\n",
+               weighted_time / iterations, equal_time / weighted_time);
+        printf("Calibration overhead = %f seconds, errors = %ld\n", calibration_time, errors);
+    }
+
+    // Clean up
+    free(local);
+    free(full);
+    free(result);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
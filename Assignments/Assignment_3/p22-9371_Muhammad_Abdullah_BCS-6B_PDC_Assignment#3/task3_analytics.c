@@ -0,0 +1,352 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc, qsort and atol
+#include <string.h> // For memset and memcpy
+#include <mpi.h>    // For MPI functions
+
+#define DEFAULT_LOCAL_COUNT (1 << 22) // Values generated by each process
+#define MAX_TOP_K 64                   // Upper bound on k for the top-k operator
+#define NUM_BINS 64                    // Fixed histogram bins over [0, 100)
+#define SKETCH_LEVELS 40               // Compactor levels (level h has weight 2^h)
+#define SKETCH_CAPACITY 256            // Items kept per level before compaction
+
+static int top_k = 10; // k used by the top-k operator (MPI_Ops cannot carry state)
+
+// Mergeable quantile sketch (KLL-style compactor stack). Fixed size, so it
+// can be shipped as one MPI datatype and merged by a user-defined MPI_Op.
+typedef struct
+{
+    long long count[SKETCH_LEVELS];                // Items stored on each level
+    double items[SKETCH_LEVELS][SKETCH_CAPACITY * 4]; // Two merged levels plus promotions from below
+    unsigned long long coin;                       // Deterministic coin for compaction offsets
+} Sketch;
+
+// xorshift64* generator, seeded per process
+static unsigned long long next_random(unsigned long long *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ULL;
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// ---------- Top-k ----------
+
+// Keep the k largest values in a min-heap of size k
+static void heap_push(double *heap, int *n, double value)
+{
+    if (*n < top_k)
+    {
+        int i = (*n)++;
+        heap[i] = value;
+        while (i > 0 && heap[(i - 1) / 2] > heap[i])
+        {
+            double t = heap[i];
+            heap[i] = heap[(i - 1) / 2];
+            heap[(i - 1) / 2] = t;
+            i = (i - 1) / 2;
+        }
+    }
+    else if (value > heap[0])
+    {
+        int i = 0;
+        heap[0] = value;
+        for (;;)
+        {
+            int l = 2 * i + 1, r = l + 1, m = i;
+            if (l < *n && heap[l] < heap[m])
+                m = l;
+            if (r < *n && heap[r] < heap[m])
+                m = r;
+            if (m == i)
+                break;
+            double t = heap[i];
+            heap[i] = heap[m];
+            heap[m] = t;
+            i = m;
+        }
+    }
+}
+
+// MPI_Op: merge two descending top-k lists into inout
+static void topk_merge(void *in, void *inout, int *len, MPI_Datatype *datatype)
+{
+    (void)datatype;
+    for (int block = 0; block < *len; block++)
+    {
+        double *a = (double *)in + block * top_k;
+        double *b = (double *)inout + block * top_k;
+        double merged[MAX_TOP_K];
+        int i = 0, j = 0;
+        for (int k = 0; k < top_k; k++)
+            merged[k] = (a[i] >= b[j]) ? a[i++] : b[j++];
+        memcpy(b, merged, top_k * sizeof(double));
+    }
+}
+
+// ---------- Quantile sketch ----------
+
+// Compact level h: sort it and promote every other item to level h + 1
+static void sketch_compact(Sketch *s, int h)
+{
+    long long n = s->count[h];
+    double *items = s->items[h];
+    qsort(items, n, sizeof(double), compare_doubles);
+
+    // Random offset (0 or 1) keeps the rank error unbiased
+    int offset = (int)(next_random(&s->coin) & 1);
+    long long pairs = n / 2;
+    for (long long i = 0; i < pairs; i++)
+        s->items[h + 1][s->count[h + 1]++] = items[2 * i + offset];
+
+    // An odd leftover stays on this level
+    if (n % 2)
+    {
+        items[0] = items[n - 1];
+        s->count[h] = 1;
+    }
+    else
+    {
+        s->count[h] = 0;
+    }
+}
+
+// Compact every level that has reached capacity, bottom-up
+static void sketch_settle(Sketch *s)
+{
+    for (int h = 0; h < SKETCH_LEVELS - 1; h++)
+        if (s->count[h] >= SKETCH_CAPACITY)
+            sketch_compact(s, h);
+}
+
+static void sketch_insert(Sketch *s, double value)
+{
+    s->items[0][s->count[0]++] = value;
+    if (s->count[0] >= SKETCH_CAPACITY)
+        sketch_settle(s);
+}
+
+// MPI_Op: merge sketch in into inout level by level. Both sides' items and
+// the promotions from below are pooled before the level is compacted, and a
+// compaction depends only on that pooled multiset (it sorts first), so the
+// result does not depend on which sketch is `in` and which is `inout`.
+static void sketch_merge(void *in, void *inout, int *len, MPI_Datatype *datatype)
+{
+    (void)datatype;
+    for (int block = 0; block < *len; block++)
+    {
+        Sketch *a = (Sketch *)in + block;
+        Sketch *b = (Sketch *)inout + block;
+        b->coin ^= a->coin;
+        for (int h = 0; h < SKETCH_LEVELS; h++)
+        {
+            memcpy(&b->items[h][b->count[h]], a->items[h], a->count[h] * sizeof(double));
+            b->count[h] += a->count[h];
+            if (h < SKETCH_LEVELS - 1 && b->count[h] >= SKETCH_CAPACITY)
+                sketch_compact(b, h);
+        }
+    }
+}
+
+typedef struct
+{
+    double value;
+    double weight;
+} Weighted;
+
+static int compare_weighted(const void *a, const void *b)
+{
+    return compare_doubles(&((const Weighted *)a)->value, &((const Weighted *)b)->value);
+}
+
+// Answer several quantile queries from a sketch
+static void sketch_quantiles(const Sketch *s, const double *qs, double *out, int nq)
+{
+    long long total_items = 0;
+    for (int h = 0; h < SKETCH_LEVELS; h++)
+        total_items += s->count[h];
+
+    Weighted *all = (Weighted *)malloc(total_items * sizeof(Weighted));
+    long long k = 0;
+    double total_weight = 0;
+    for (int h = 0; h < SKETCH_LEVELS; h++)
+        for (long long i = 0; i < s->count[h]; i++)
+        {
+            all[k].value = s->items[h][i];
+            all[k].weight = (double)(1ULL << h);
+            total_weight += all[k].weight;
+            k++;
+        }
+    qsort(all, total_items, sizeof(Weighted), compare_weighted);
+
+    for (int q = 0; q < nq; q++)
+    {
+        double target = qs[q] * total_weight, cumulative = 0;
+        out[q] = all[total_items - 1].value;
+        for (long long i = 0; i < total_items; i++)
+        {
+            cumulative += all[i].weight;
+            if (cumulative >= target)
+            {
+                out[q] = all[i].value;
+                break;
+            }
+        }
+    }
+    free(all);
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    long n = DEFAULT_LOCAL_COUNT; // Values per process
+    double start_time, end_time;  // For timing each analytic
+
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task3_analytics [values_per_process] [k]
+    if (argc > 1)
+        n = atol(argv[1]);
+    if (argc > 2)
+        top_k = atoi(argv[2]);
+    if (n < top_k || top_k <= 0 || top_k > MAX_TOP_K)
+    {
+        if (rank == 0)
+            printf("Error: need 1 <= k <= %d and at least k values per process.\n", MAX_TOP_K);
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Generate skewed values in [0, 100): value = 100 * u^2, so quantile q is 100 * q^2
+    double *values = (double *)malloc(n * sizeof(double));
+    unsigned long long state = 0x9E3779B97F4A7C15ULL * (rank + 1);
+    for (long i = 0; i < n; i++)
+    {
+        double u = (next_random(&state) >> 11) * (1.0 / 9007199254740992.0);
+        values[i] = 100.0 * u * u;
+    }
+
+    // ---------- Exact global top-k with a custom MPI_Op ----------
+    MPI_Datatype topk_type;
+    MPI_Op topk_op;
+    MPI_Type_contiguous(top_k, MPI_DOUBLE, &topk_type);
+    MPI_Type_commit(&topk_type);
+    MPI_Op_create(topk_merge, 1, &topk_op);
+
+    double local_top[MAX_TOP_K], global_top[MAX_TOP_K];
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    int heap_size = 0;
+    for (long i = 0; i < n; i++)
+        heap_push(local_top, &heap_size, values[i]);
+    qsort(local_top, top_k, sizeof(double), compare_doubles);
+    for (int i = 0; i < top_k / 2; i++) // Descending order for the merge
+    {
+        double t = local_top[i];
+        local_top[i] = local_top[top_k - 1 - i];
+        local_top[top_k - 1 - i] = t;
+    }
+    MPI_Allreduce(local_top, global_top, 1, topk_type, topk_op, MPI_COMM_WORLD);
+    end_time = MPI_Wtime();
+    double topk_time = end_time - start_time;
+
+    // ---------- Fixed-bin histogram with MPI_Reduce_scatter ----------
+    long long local_hist[NUM_BINS], global_hist[NUM_BINS];
+    int recv_counts[size], displs[size];
+    for (int r = 0, offset = 0; r < size; r++)
+    {
+        recv_counts[r] = NUM_BINS / size + (r < NUM_BINS % size ? 1 : 0);
+        displs[r] = offset;
+        offset += recv_counts[r];
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    memset(local_hist, 0, sizeof(local_hist));
+    for (long i = 0; i < n; i++)
+    {
+        int bin = (int)(values[i] * (NUM_BINS / 100.0));
+        local_hist[bin < NUM_BINS ? bin : NUM_BINS - 1]++;
+    }
+
+    // Each process ends up owning the totals of its share of the bins...
+    long long owned_bins[NUM_BINS];
+    MPI_Reduce_scatter(local_hist, owned_bins, recv_counts, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+    // ...and the shares are concatenated so every process has the full histogram
+    MPI_Allgatherv(owned_bins, recv_counts[rank], MPI_LONG_LONG,
+                   global_hist, recv_counts, displs, MPI_LONG_LONG, MPI_COMM_WORLD);
+    end_time = MPI_Wtime();
+    double hist_time = end_time - start_time;
+
+    // ---------- Approximate quantiles with a mergeable sketch ----------
+    Sketch *local_sketch = (Sketch *)calloc(1, sizeof(Sketch));
+    Sketch *global_sketch = (Sketch *)calloc(1, sizeof(Sketch));
+    MPI_Datatype sketch_type;
+    MPI_Op sketch_op;
+    MPI_Type_contiguous(sizeof(Sketch), MPI_BYTE, &sketch_type);
+    MPI_Type_commit(&sketch_type);
+    MPI_Op_create(sketch_merge, 1, &sketch_op);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    local_sketch->coin = 0xD1B54A32D192ED03ULL * (rank + 1);
+    for (long i = 0; i < n; i++)
+        sketch_insert(local_sketch, values[i]);
+
+    // The reduction combines sketches pairwise in a tree
+    MPI_Allreduce(local_sketch, global_sketch, 1, sketch_type, sketch_op, MPI_COMM_WORLD);
+    double qs[] = {0.5, 0.9, 0.99};
+    double quantiles[3];
+    sketch_quantiles(global_sketch, qs, quantiles, 3);
+    end_time = MPI_Wtime();
+    double sketch_time = end_time - start_time;
+
+    // Every process now holds the same results; process 0 reports them
+    if (rank == 0)
+    {
+        long long total = 0;
+        for (int b = 0; b < NUM_BINS; b++)
+            total += global_hist[b];
+
+        printf("Analytics over %ld values (%ld per process, %d processes)\n", n * size, n, size);
+        printf("Top-%d values:", top_k);
+        for (int i = 0; i < top_k; i++)
+            printf(" %.4f", global_top[i]);
+        printf("\nTop-k time = %.6f seconds (%d bytes per message)\n",
+               topk_time, (int)(top_k * sizeof(double)));
+
+        printf("Histogram (%d bins, %lld values counted), first bins:", NUM_BINS, total);
+        for (int b = 0; b < 8; b++)
+            printf(" %lld", global_hist[b]);
+        printf("\nHistogram time = %.6f seconds (%d bins reduced per process)\n",
+               hist_time, recv_counts[0]);
+
+        for (int q = 0; q < 3; q++)
+            printf("Quantile p%g = %.4f (expected %.4f)\n",
+                   qs[q] * 100, quantiles[q], 100.0 * qs[q] * qs[q]);
+        printf("Sketch time = %.6f seconds (%d bytes per message)\n",
+               sketch_time, (int)sizeof(Sketch));
+    }
+
+    // Clean up
+    MPI_Op_free(&topk_op);
+    MPI_Op_free(&sketch_op);
+    MPI_Type_free(&topk_type);
+    MPI_Type_free(&sketch_type);
+    free(local_sketch);
+    free(global_sketch);
+    free(values);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,265 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc, qsort and atol
+#include <string.h> // For strcmp
+#include <mpi.h>    // For MPI functions
+
+#define DEFAULT_MAX_BYTES (1 << 20) // Largest per-process message in the sweep
+#define DEFAULT_REPS 100            // Measured repetitions per size
+#define WARMUP_REPS 10              // Untimed repetitions before measuring
+#define SYNC_ROUNDS 20              // Ping-pongs per process when syncing clocks
+#define MAX_WINDOW 0.1              // Upper bound (s) on the lead time of a start announcement
+#define MAX_ATTEMPTS 4              // Measured attempts allowed per size, as a multiple of the repetitions
+
+enum
+{
+    BCAST,
+    SCATTER,
+    SCATTERV,
+    GATHER,
+    GATHERV,
+    ALLGATHER,
+    REDUCE,
+    ALLREDUCE,
+    ALLTOALL,
+    REDUCE_SCATTER,
+    NUM_OPS
+};
+
+static const char *op_names[NUM_OPS] = {"bcast",     "scatter", "scatterv",  "gather",   "gatherv",
+                                        "allgather", "reduce",  "allreduce", "alltoall", "reduce_scatter"};
+
+// Data the algorithm moves, in blocks of `bytes`: one block for rooted and
+// element-wise collectives, one per process for the personalized/gathering ones
+static int blocks_moved(int op, int size)
+{
+    return (op == BCAST || op == REDUCE || op == ALLREDUCE) ? 1 : size;
+}
+
+// One call of the collective on `count` doubles per process
+static void run_op(int op, int count, double *send, double *recv, int *counts, int *displs, MPI_Comm comm)
+{
+    switch (op)
+    {
+    case BCAST:
+        MPI_Bcast(send, count, MPI_DOUBLE, 0, comm);
+        break;
+    case SCATTER:
+        MPI_Scatter(send, count, MPI_DOUBLE, recv, count, MPI_DOUBLE, 0, comm);
+        break;
+    case SCATTERV:
+        MPI_Scatterv(send, counts, displs, MPI_DOUBLE, recv, count, MPI_DOUBLE, 0, comm);
+        break;
+    case GATHER:
+        MPI_Gather(send, count, MPI_DOUBLE, recv, count, MPI_DOUBLE, 0, comm);
+        break;
+    case GATHERV:
+        MPI_Gatherv(send, count, MPI_DOUBLE, recv, counts, displs, MPI_DOUBLE, 0, comm);
+        break;
+    case ALLGATHER:
+        MPI_Allgather(send, count, MPI_DOUBLE, recv, count, MPI_DOUBLE, comm);
+        break;
+    case REDUCE:
+        MPI_Reduce(send, recv, count, MPI_DOUBLE, MPI_SUM, 0, comm);
+        break;
+    case ALLREDUCE:
+        MPI_Allreduce(send, recv, count, MPI_DOUBLE, MPI_SUM, comm);
+        break;
+    case ALLTOALL:
+        MPI_Alltoall(send, count, MPI_DOUBLE, recv, count, MPI_DOUBLE, comm);
+        break;
+    default:
+        MPI_Reduce_scatter(send, recv, counts, MPI_DOUBLE, MPI_SUM, comm);
+        break;
+    }
+}
+
+// Offset of this process's MPI_Wtime against process 0's, from the ping-pong
+// with the smallest round trip (the one least disturbed by noise)
+static double sync_clock(int rank, int size)
+{
+    double offset = 0;
+    for (int r = 1; r < size; r++)
+    {
+        if (rank == 0)
+        {
+            double best_rtt = 1e30, best_offset = 0;
+            for (int k = 0; k < SYNC_ROUNDS; k++)
+            {
+                double t0 = MPI_Wtime(), remote;
+                MPI_Send(&t0, 1, MPI_DOUBLE, r, 0, MPI_COMM_WORLD);
+                MPI_Recv(&remote, 1, MPI_DOUBLE, r, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                double t1 = MPI_Wtime();
+                if (t1 - t0 < best_rtt)
+                {
+                    best_rtt = t1 - t0;
+                    best_offset = remote - (t0 + t1) / 2;
+                }
+            }
+            MPI_Send(&best_offset, 1, MPI_DOUBLE, r, 0, MPI_COMM_WORLD);
+        }
+        else if (rank == r)
+        {
+            for (int k = 0; k < SYNC_ROUNDS; k++)
+            {
+                double t0, now;
+                MPI_Recv(&t0, 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                now = MPI_Wtime();
+                MPI_Send(&now, 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
+            }
+            MPI_Recv(&offset, 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        }
+    }
+    return offset;
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, int n, double q)
+{
+    return sorted[(int)(q * (n - 1) + 0.5)];
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    long max_bytes = DEFAULT_MAX_BYTES; // Largest message per process
+    int reps = DEFAULT_REPS;            // Measured repetitions
+    const char *only = "all";           // One collective, or all of them
+
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task3_bench [max_bytes_per_process] [repetitions] [collective|all]
+    if (argc > 1)
+        max_bytes = atol(argv[1]);
+    if (argc > 2)
+        reps = atoi(argv[2]);
+    if (argc > 3)
+        only = argv[3];
+
+    int known = strcmp(only, "all") == 0;
+    for (int op = 0; op < NUM_OPS; op++)
+        known |= strcmp(only, op_names[op]) == 0;
+    if (max_bytes < (long)sizeof(double) || reps <= 0 || !known)
+    {
+        if (rank == 0)
+            printf("Error: bad size or repetition count, or unknown collective '%s'.\n", only);
+        MPI_Finalize();
+        return 1;
+    }
+
+    long max_count = max_bytes / sizeof(double);
+    double *send = (double *)malloc(max_count * size * sizeof(double));
+    double *recv = (double *)malloc(max_count * size * sizeof(double));
+    for (long i = 0; i < max_count * size; i++)
+        send[i] = rank + 1;
+    int counts[size], displs[size];
+    double *latencies = (double *)malloc(reps * sizeof(double));
+
+    if (rank == 0)
+    {
+        printf("Collective latency, %d processes, %d repetitions after %d warm-up\n", size, reps, WARMUP_REPS);
+        printf("Latency = last process done - common start time, on clocks synced to process 0\n");
+        printf("late = repetitions discarded (and replaced) because a process missed the start\n");
+        printf("%-15s %10s %10s %10s %10s %10s %10s %12s %6s\n", "collective", "bytes", "min (us)", "p50 (us)",
+               "p90 (us)", "p99 (us)", "max (us)", "algbw (GB/s)", "late");
+    }
+
+    for (int op = 0; op < NUM_OPS; op++)
+    {
+        if (strcmp(only, "all") != 0 && strcmp(only, op_names[op]) != 0)
+            continue;
+
+        for (long bytes = sizeof(double); bytes <= max_bytes; bytes *= 4)
+        {
+            int count = (int)(bytes / sizeof(double));
+            for (int r = 0; r < size; r++)
+            {
+                counts[r] = count;
+                displs[r] = r * count;
+            }
+
+            // Re-sync every size so drift stays small, then size the start window
+            // from the cost of the broadcast that announces it
+            double offset = sync_clock(rank, size);
+            double window = 0;
+            for (int k = 0; k < 5; k++)
+            {
+                MPI_Barrier(MPI_COMM_WORLD);
+                double t = MPI_Wtime();
+                MPI_Bcast(&window, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+                t = MPI_Wtime() - t;
+                MPI_Allreduce(&t, &window, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+            }
+            window = 4 * window + 50e-6;
+
+            // Warm-up repetitions use the same protocol and also settle the window:
+            // it doubles whenever some process missed the announced start. A
+            // measured repetition with a late process would include its late
+            // arrival, so it is discarded and replaced, up to a bounded budget.
+            int late = 0, measured = 0;
+            for (int warm = 0, attempts = 0; measured < reps && attempts < MAX_ATTEMPTS * reps;)
+            {
+                // Everyone starts at the same global instant, announced ahead of time
+                double start = 0;
+                if (rank == 0)
+                    start = MPI_Wtime() + window;
+                MPI_Bcast(&start, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+                int was_late = MPI_Wtime() - offset > start;
+                while (MPI_Wtime() - offset < start)
+                    ;
+
+                run_op(op, count, send, recv, counts, displs, MPI_COMM_WORLD);
+                double elapsed = MPI_Wtime() - offset - start;
+
+                // Latency of this repetition is the slowest process; every process
+                // needs the late flag to agree on whether to run a replacement
+                double local[2] = {elapsed, (double)was_late}, global[2];
+                MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+                if (rank == 0 && global[1] > 0 && window < MAX_WINDOW)
+                    window *= 2;
+
+                if (warm < WARMUP_REPS)
+                {
+                    warm++;
+                    continue;
+                }
+                attempts++;
+                if (global[1] > 0)
+                    late++;
+                else
+                    latencies[measured++] = global[0];
+            }
+
+            if (rank == 0 && measured == 0)
+                printf("%-15s %10ld %10s %10s %10s %10s %10s %12s %6d\n", op_names[op], bytes, "-", "-", "-", "-",
+                       "-", "-", late);
+            else if (rank == 0)
+            {
+                qsort(latencies, measured, sizeof(double), compare_doubles);
+                double median = percentile(latencies, measured, 0.5);
+                printf("%-15s %10ld %10.2f %10.2f %10.2f %10.2f %10.2f %12.3f %6d\n", op_names[op], bytes,
+                       latencies[0] * 1e6, median * 1e6, percentile(latencies, measured, 0.9) * 1e6,
+                       percentile(latencies, measured, 0.99) * 1e6, latencies[measured - 1] * 1e6,
+                       (double)bytes * blocks_moved(op, size) / median / 1e9, late);
+            }
+            if (rank == 0 && measured < reps)
+                printf("  (only %d of %d repetitions started on time; percentiles use those)\n", measured, reps);
+        }
+    }
+
+    // Clean up
+    free(send);
+    free(recv);
+    free(latencies);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,340 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc and atol
+#include <string.h> // For memcpy
+#include <math.h>   // For INFINITY, NAN and sqrt
+#include <mpi.h>    // For MPI functions
+
+#define DEFAULT_FEATURES (1 << 14) // Columns; one set of statistics per column
+#define DEFAULT_ROWS 256           // Rows (samples) held by each process
+#define LANES 8                    // Columns per block, one vector register of doubles
+#define MISSING_EVERY 97           // Roughly one value in 97 is missing (NaN)
+
+// Every statistic of LANES columns, stored field by field so each field is
+// one contiguous run of LANES values. One block is one MPI element, and the
+// merge below is a straight-line loop over lanes the compiler can vectorize.
+typedef struct
+{
+    double min[LANES], max[LANES], sum[LANES], sumsq[LANES];
+    long long count[LANES]; // Values that were not missing
+    long long rank[LANES];  // Process holding the maximum
+    long long row[LANES];   // Row of the maximum on that process
+} StatsBlock;
+
+// The same statistics for a single column, merged one column at a time
+typedef struct
+{
+    double min, max, sum, sumsq;
+    long long count, rank, row;
+} Stats;
+
+// Element of MPI_DOUBLE_INT, as used by MPI_MAXLOC
+typedef struct
+{
+    double value;
+    int rank;
+} DoubleInt;
+
+// Value of (row, column) on a process: uniform in [0, 100) with some missing
+static double input_value(int rank, long row, long column)
+{
+    unsigned long long x = ((unsigned long long)rank << 48) ^ ((unsigned long long)row << 24) ^ (unsigned long long)column;
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    if (x % MISSING_EVERY == 0)
+        return NAN;
+    return (x >> 11) * (100.0 / 9007199254740992.0);
+}
+
+// Argmax winner: larger value, ties go to the lowest (rank, row)
+static int beats(double value, long long rank, long long row, double best, long long best_rank, long long best_row)
+{
+    return value > best || (value == best && (rank < best_rank || (rank == best_rank && row < best_row)));
+}
+
+// MPI_Op: min, max, sum, sum of squares, count and argmax of LANES columns in one pass
+static void stats_merge(void *in, void *inout, int *len, MPI_Datatype *datatype)
+{
+    (void)datatype;
+    const StatsBlock *a = (const StatsBlock *)in;
+    StatsBlock *b = (StatsBlock *)inout;
+    for (int block = 0; block < *len; block++, a++, b++)
+        for (int l = 0; l < LANES; l++)
+        {
+            int take = beats(a->max[l], a->rank[l], a->row[l], b->max[l], b->rank[l], b->row[l]);
+            b->rank[l] = take ? a->rank[l] : b->rank[l];
+            b->row[l] = take ? a->row[l] : b->row[l];
+            b->max[l] = take ? a->max[l] : b->max[l];
+            b->min[l] = a->min[l] < b->min[l] ? a->min[l] : b->min[l];
+            b->sum[l] += a->sum[l];
+            b->sumsq[l] += a->sumsq[l];
+            b->count[l] += a->count[l];
+        }
+}
+
+// MPI_Op: the same merge over one column per element, for comparison
+static void stats_merge_scalar(void *in, void *inout, int *len, MPI_Datatype *datatype)
+{
+    (void)datatype;
+    const Stats *a = (const Stats *)in;
+    Stats *b = (Stats *)inout;
+    for (int i = 0; i < *len; i++)
+    {
+        if (beats(a[i].max, a[i].rank, a[i].row, b[i].max, b[i].rank, b[i].row))
+        {
+            b[i].max = a[i].max;
+            b[i].rank = a[i].rank;
+            b[i].row = a[i].row;
+        }
+        if (a[i].min < b[i].min)
+            b[i].min = a[i].min;
+        b[i].sum += a[i].sum;
+        b[i].sumsq += a[i].sumsq;
+        b[i].count += a[i].count;
+    }
+}
+
+// One pass over the local rows; missing values are skipped without branching
+static void local_stats(const double *values, long rows, long blocks, int rank, StatsBlock *stats)
+{
+    for (long b = 0; b < blocks; b++)
+        for (int l = 0; l < LANES; l++)
+        {
+            stats[b].min[l] = INFINITY;
+            stats[b].max[l] = -INFINITY;
+            stats[b].sum[l] = stats[b].sumsq[l] = 0;
+            stats[b].count[l] = 0;
+            stats[b].rank[l] = rank;
+            stats[b].row[l] = -1;
+        }
+
+    for (long r = 0; r < rows; r++)
+        for (long b = 0; b < blocks; b++)
+        {
+            const double *v = &values[(r * blocks + b) * LANES];
+            StatsBlock *s = &stats[b];
+            for (int l = 0; l < LANES; l++)
+            {
+                int present = v[l] == v[l]; // False only for NaN
+                double x = present ? v[l] : 0.0;
+                int larger = v[l] > s->max[l];
+                s->row[l] = larger ? r : s->row[l];
+                s->max[l] = larger ? v[l] : s->max[l];
+                s->min[l] = v[l] < s->min[l] ? v[l] : s->min[l];
+                s->sum[l] += x;
+                s->sumsq[l] += x * x;
+                s->count[l] += present;
+            }
+        }
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    long features = DEFAULT_FEATURES; // Columns
+    long rows = DEFAULT_ROWS;         // Rows per process
+    int iterations = 20;              // Reductions per measurement
+
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task3_reduce_ops [features] [rows_per_process] [iterations]
+    if (argc > 1)
+        features = atol(argv[1]);
+    if (argc > 2)
+        rows = atol(argv[2]);
+    if (argc > 3)
+        iterations = atoi(argv[3]);
+
+    if (features <= 0 || rows <= 0 || iterations <= 0)
+    {
+        if (rank == 0)
+            printf("Error: features, rows and iterations must be positive.\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Columns are padded up to whole blocks; padding lanes stay empty
+    long blocks = (features + LANES - 1) / LANES;
+    long columns = blocks * LANES;
+    double *values = (double *)malloc(rows * columns * sizeof(double));
+    for (long r = 0; r < rows; r++)
+        for (long c = 0; c < columns; c++)
+            values[r * columns + c] = c < features ? input_value(rank, r, c) : NAN;
+
+    StatsBlock *local = (StatsBlock *)malloc(blocks * sizeof(StatsBlock));
+    StatsBlock *fused = (StatsBlock *)malloc(blocks * sizeof(StatsBlock));
+    Stats *scalar_local = (Stats *)malloc(columns * sizeof(Stats));
+    Stats *scalar = (Stats *)malloc(columns * sizeof(Stats));
+    local_stats(values, rows, blocks, rank, local);
+
+    // Same local statistics, one struct per column, for the scalar operator
+    for (long c = 0; c < columns; c++)
+    {
+        const StatsBlock *s = &local[c / LANES];
+        int l = c % LANES;
+        Stats t = {s->min[l], s->max[l], s->sum[l], s->sumsq[l], s->count[l], s->rank[l], s->row[l]};
+        scalar_local[c] = t;
+    }
+
+    // Field arrays for the chain of built-in reductions
+    double *mins = (double *)malloc(columns * sizeof(double));
+    double *maxs = (double *)malloc(columns * sizeof(double));
+    double *sums = (double *)malloc(columns * sizeof(double));
+    double *sumsqs = (double *)malloc(columns * sizeof(double));
+    long long *counts = (long long *)malloc(columns * sizeof(long long));
+    long long *argrows = (long long *)malloc(columns * sizeof(long long));
+    DoubleInt *maxlocs = (DoubleInt *)malloc(columns * sizeof(DoubleInt));
+    double *out_min = (double *)malloc(columns * sizeof(double));
+    double *out_max = (double *)malloc(columns * sizeof(double));
+    double *out_sum = (double *)malloc(columns * sizeof(double));
+    double *out_sumsq = (double *)malloc(columns * sizeof(double));
+    long long *out_count = (long long *)malloc(columns * sizeof(long long));
+    long long *out_row = (long long *)malloc(columns * sizeof(long long));
+    DoubleInt *out_maxloc = (DoubleInt *)malloc(columns * sizeof(DoubleInt));
+    for (long c = 0; c < columns; c++)
+    {
+        mins[c] = scalar_local[c].min;
+        maxs[c] = scalar_local[c].max;
+        sums[c] = scalar_local[c].sum;
+        sumsqs[c] = scalar_local[c].sumsq;
+        counts[c] = scalar_local[c].count;
+        maxlocs[c].value = scalar_local[c].max;
+        maxlocs[c].rank = rank;
+    }
+
+    // One block (or one column) = one MPI element
+    MPI_Datatype block_type, stats_type;
+    MPI_Type_contiguous(sizeof(StatsBlock), MPI_BYTE, &block_type);
+    MPI_Type_commit(&block_type);
+    MPI_Type_contiguous(sizeof(Stats), MPI_BYTE, &stats_type);
+    MPI_Type_commit(&stats_type);
+    MPI_Op stats_op, scalar_op;
+    MPI_Op_create(stats_merge, 1, &stats_op);
+    MPI_Op_create(stats_merge_scalar, 1, &scalar_op);
+
+    double start_time, builtin_time, scalar_time, fused_time;
+
+    // ---------- Chained built-in reductions: seven collectives ----------
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    for (int it = 0; it < iterations; it++)
+    {
+        MPI_Allreduce(mins, out_min, (int)columns, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+        MPI_Allreduce(maxs, out_max, (int)columns, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        MPI_Allreduce(sums, out_sum, (int)columns, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        MPI_Allreduce(sumsqs, out_sumsq, (int)columns, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        MPI_Allreduce(counts, out_count, (int)columns, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+        // MPI_MAXLOC only carries the rank; the owner then contributes its row
+        MPI_Allreduce(maxlocs, out_maxloc, (int)columns, MPI_DOUBLE_INT, MPI_MAXLOC, MPI_COMM_WORLD);
+        for (long c = 0; c < columns; c++)
+            argrows[c] = out_maxloc[c].rank == rank ? scalar_local[c].row : -1;
+        MPI_Allreduce(argrows, out_row, (int)columns, MPI_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    builtin_time = (MPI_Wtime() - start_time) / iterations;
+
+    // ---------- One collective, scalar operator ----------
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    for (int it = 0; it < iterations; it++)
+        MPI_Allreduce(scalar_local, scalar, (int)columns, stats_type, scalar_op, MPI_COMM_WORLD);
+    MPI_Barrier(MPI_COMM_WORLD);
+    scalar_time = (MPI_Wtime() - start_time) / iterations;
+
+    // ---------- One collective, vectorized operator ----------
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    for (int it = 0; it < iterations; it++)
+        MPI_Allreduce(local, fused, (int)blocks, block_type, stats_op, MPI_COMM_WORLD);
+    MPI_Barrier(MPI_COMM_WORLD);
+    fused_time = (MPI_Wtime() - start_time) / iterations;
+
+    // Operator throughput on its own, without communication
+    StatsBlock *scratch = (StatsBlock *)malloc(blocks * sizeof(StatsBlock));
+    Stats *scalar_scratch = (Stats *)malloc(columns * sizeof(Stats));
+    int block_len = (int)blocks, column_len = (int)columns;
+    double op_time, scalar_op_time;
+    memcpy(scratch, local, blocks * sizeof(StatsBlock));
+    start_time = MPI_Wtime();
+    for (int it = 0; it < iterations; it++)
+        stats_merge(local, scratch, &block_len, &block_type);
+    op_time = (MPI_Wtime() - start_time) / iterations;
+    memcpy(scalar_scratch, scalar_local, columns * sizeof(Stats));
+    start_time = MPI_Wtime();
+    for (int it = 0; it < iterations; it++)
+        stats_merge_scalar(scalar_local, scalar_scratch, &column_len, &stats_type);
+    scalar_op_time = (MPI_Wtime() - start_time) / iterations;
+
+    // All three methods must agree on every real column
+    long errors = 0;
+    for (long c = 0; c < features; c++)
+    {
+        const StatsBlock *f = &fused[c / LANES];
+        int l = c % LANES;
+        double tolerance = 1e-9 * (fabs(out_sumsq[c]) + 1);
+        if (f->min[l] != out_min[c] || f->max[l] != out_max[c] || f->count[l] != out_count[c] ||
+            f->rank[l] != out_maxloc[c].rank || f->row[l] != out_row[c] ||
+            fabs(f->sum[l] - out_sum[c]) > tolerance || fabs(f->sumsq[l] - out_sumsq[c]) > tolerance)
+            errors++;
+        if (scalar[c].min != f->min[l] || scalar[c].max != f->max[l] || scalar[c].count != f->count[l] ||
+            scalar[c].rank != f->rank[l] || scalar[c].row != f->row[l] ||
+            fabs(scalar[c].sum - f->sum[l]) > tolerance || fabs(scalar[c].sumsq - f->sumsq[l]) > tolerance)
+            errors++;
+    }
+    long total_errors;
+    MPI_Reduce(&errors, &total_errors, 1, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        double mean = fused[0].sum[0] / fused[0].count[0];
+        double variance = fused[0].sumsq[0] / fused[0].count[0] - mean * mean;
+        printf("Column statistics: %ld columns x %ld rows per process, %d processes\n", features, rows, size);
+        printf("Column 0: min %.3f, max %.3f (process %lld, row %lld), mean %.3f, stddev %.3f, %lld values\n",
+               fused[0].min[0], fused[0].max[0], fused[0].rank[0], fused[0].row[0], mean, sqrt(variance),
+               fused[0].count[0]);
+        printf("%-28s %8s %14s\n", "method", "calls", "time (us)");
+        printf("%-28s %8d %14.1f\n", "built-in ops (chained)", 7, builtin_time * 1e6);
+        printf("%-28s %8d %14.1f (%.2fx)\n", "custom op, scalar", 1, scalar_time * 1e6, builtin_time / scalar_time);
+        printf("%-28s %8d %14.1f (%.2fx)\n", "custom op, vectorized", 1, fused_time * 1e6, builtin_time / fused_time);
+        printf("Operator alone: scalar %.2f GB/s, vectorized %.2f GB/s\n",
+               columns * sizeof(Stats) / scalar_op_time / 1e9, blocks * sizeof(StatsBlock) / op_time / 1e9);
+        printf("Mismatched columns = %ld\n", total_errors);
+    }
+
+    // Clean up
+    free(values);
+    free(local);
+    free(fused);
+    free(scalar_local);
+    free(scalar);
+    free(scratch);
+    free(scalar_scratch);
+    free(mins);
+    free(maxs);
+    free(sums);
+    free(sumsqs);
+    free(counts);
+    free(argrows);
+    free(maxlocs);
+    free(out_min);
+    free(out_max);
+    free(out_sum);
+    free(out_sumsq);
+    free(out_count);
+    free(out_row);
+    free(out_maxloc);
+    MPI_Op_free(&stats_op);
+    MPI_Op_free(&scalar_op);
+    MPI_Type_free(&block_type);
+    MPI_Type_free(&stats_type);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include <stdio.h>  // For input/output functions
+#include <stdlib.h> // For malloc, rand and strtoull
+#include <stdint.h> // For fixed-width integer types
+#include <mpi.h>    // For MPI functions
+
+#define DEFAULT_GLOBAL_SIZE (1L << 26) // Total elements in the generated array
+#define BATCH 16                       // Philox blocks generated together (one vector loop)
+#define PHILOX_M0 0xD2511F53u          // Philox4x32 round multipliers
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u          // Philox4x32 key schedule increments
+#define PHILOX_W1 0xBB67AE85u
+
+// Philox4x32-10 over BATCH consecutive counters. Counter block b produces
+// four 32-bit outputs; the lanes are kept in separate arrays so each round
+// is a straight loop over BATCH values that the compiler can vectorize.
+static void philox_batch(uint64_t first_block, uint64_t seed, uint32_t out[4][BATCH])
+{
+    uint32_t c0[BATCH], c1[BATCH], c2[BATCH], c3[BATCH];
+    uint32_t k0 = (uint32_t)seed, k1 = (uint32_t)(seed >> 32);
+
+    for (int l = 0; l < BATCH; l++)
+    {
+        uint64_t block = first_block + l;
+        c0[l] = (uint32_t)block;
+        c1[l] = (uint32_t)(block >> 32);
+        c2[l] = 0;
+        c3[l] = 0;
+    }
+
+    for (int round = 0; round < 10; round++)
+    {
+        for (int l = 0; l < BATCH; l++)
+        {
+            uint64_t p0 = (uint64_t)PHILOX_M0 * c0[l];
+            uint64_t p1 = (uint64_t)PHILOX_M1 * c2[l];
+            uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1[l] ^ k0;
+            uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3[l] ^ k1;
+            c1[l] = (uint32_t)p1;
+            c3[l] = (uint32_t)p0;
+            c0[l] = n0;
+            c2[l] = n2;
+        }
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    for (int l = 0; l < BATCH; l++)
+    {
+        out[0][l] = c0[l];
+        out[1][l] = c1[l];
+        out[2][l] = c2[l];
+        out[3][l] = c3[l];
+    }
+}
+
+// Map a 32-bit random word to an integer in [1, 100] (multiply-shift, as task3.c's range)
+static int to_range(uint32_t x)
+{
+    return (int)(((uint64_t)x * 100) >> 32) + 1;
+}
+
+// Fill values[0 .. count) with the elements at global indices first .. first+count.
+// Element i is lane i % 4 of counter block i / 4, so the result depends only on
+// (seed, global index) and never on which process generated it.
+static void fill_range(uint64_t seed, uint64_t first, long count, int *values)
+{
+    uint32_t out[4][BATCH];
+    uint64_t index = first;
+    long written = 0;
+
+    while (written < count)
+    {
+        uint64_t block = index / 4;
+        philox_batch(block, seed, out);
+
+        // Copy every lane of the batch that falls inside the requested range
+        for (int l = 0; l < BATCH && written < count; l++)
+            for (int lane = (int)((index - (block + l) * 4)); lane < 4 && written < count; lane++)
+            {
+                values[written++] = to_range(out[lane][l]);
+                index++;
+            }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    long global_size = DEFAULT_GLOBAL_SIZE; // Elements across all processes
+    uint64_t seed = 2025;                   // Seed shared by every process
+    double start_time, end_time;            // For timing the generators
+
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Usage: task3_rng [global_size] [seed]
+    if (argc > 1)
+        global_size = atol(argv[1]);
+    if (argc > 2)
+        seed = strtoull(argv[2], NULL, 10);
+
+    if (global_size < size)
+    {
+        if (rank == 0)
+            printf("Error: Array size %ld is smaller than the process count %d.\n", global_size, size);
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Known-answer check: Philox4x32-10 with zero key and counter
+    if (rank == 0)
+    {
+        uint32_t out[4][BATCH];
+        philox_batch(0, 0, out);
+        int ok = out[0][0] == 0x6627e8d5u && out[1][0] == 0xe169c58du &&
+                 out[2][0] == 0xbc57ac4cu && out[3][0] == 0x9b00dbd8u;
+        printf("Process 0: Philox known-answer check %s\n", ok ? "passed" : "FAILED");
+    }
+
+    // Block distribution of the global array; remainder goes to the first processes
+    long local_size = global_size / size + (rank < global_size % size ? 1 : 0);
+    long first = rank * (global_size / size) + (rank < global_size % size ? rank : global_size % size);
+    int *values = (int *)malloc(local_size * sizeof(int));
+
+    // ---------- Counter-based generation ----------
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    fill_range(seed, first, local_size, values);
+    MPI_Barrier(MPI_COMM_WORLD);
+    end_time = MPI_Wtime();
+    double philox_time = end_time - start_time;
+
+    // ---------- rand() baseline (what task3.c uses) ----------
+    MPI_Barrier(MPI_COMM_WORLD);
+    start_time = MPI_Wtime();
+    srand(seed + rank);
+    long long rand_sum = 0;
+    for (long i = 0; i < local_size; i++)
+        rand_sum += (rand() % 100) + 1;
+    MPI_Barrier(MPI_COMM_WORLD);
+    end_time = MPI_Wtime();
+    double rand_time = end_time - start_time;
+
+    // Statistics of task3.c, plus a position-sensitive checksum. All of them are
+    // identical for any process count because element i is fixed by (seed, i).
+    long long local_sum = 0, global_sum = 0;
+    unsigned long long local_check = 0, global_check = 0;
+    int local_max = 0, global_max = 0;
+    for (long i = 0; i < local_size; i++)
+    {
+        local_sum += values[i];
+        local_check += (unsigned long long)values[i] * (unsigned long long)(first + i + 1);
+        if (values[i] > local_max)
+            local_max = values[i];
+    }
+    MPI_Reduce(&local_sum, &global_sum, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&local_check, &global_check, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&local_max, &global_max, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        double bytes = (double)global_size * sizeof(int);
+        printf("Generated %ld values on %d processes with seed %llu\n",
+               global_size, size, (unsigned long long)seed);
+        printf("Max value = %d, Average value = %.4f, Checksum = %llu\n",
+               global_max, (double)global_sum / global_size, global_check);
+        printf("Philox time = %.6f seconds (%.2f GB/s aggregate)\n",
+               philox_time, bytes / philox_time / 1e9);
+        printf("rand() time = %.6f seconds (%.2f GB/s aggregate, not reproducible)\n",
+               rand_time, bytes / rand_time / 1e9);
+    }
+
+    // Keep the baseline loop from being optimized away
+    if (rand_sum < 0)
+        printf("Process %d: unexpected rand() sum\n", rank);
+
+    // Clean up
+    free(values);
+
+    // Finalize MPI
+    MPI_Finalize();
+    return 0;
+}